@@ -5,6 +5,9 @@
 #include "HashTableDictionary.h"
 #include "PriorityQueue.h"
 #include "ArraySequence.h"
+#include "Arena.h"
+#include "GraphFile.h"
+#include "GraphBatch.h"
 
 template <typename T>
 class DirectedGraph : public IGraph<T> {
@@ -16,7 +19,7 @@ private:
         component->Add(vertex);
         auto edges = GetEdges(vertex);
         for (size_t i = 0; i < edges->GetLength(); ++i) {
-            size_t neighbor = edges->Get(i).first;
+            size_t neighbor = edges->UncheckedGet(i).first;
             if (!visited.Get(neighbor)) {
                 DFS(neighbor, visited, component);
             }
@@ -27,7 +30,7 @@ private:
         visited.Get(vertex) = true;
         auto edges = GetEdges(vertex);
         for (size_t i = 0; i < edges->GetLength(); ++i) {
-            size_t neighbor = edges->Get(i).first;
+            size_t neighbor = edges->UncheckedGet(i).first;
             if (!visited.Get(neighbor)) {
                 FillOrder(neighbor, visited, stack);
             }
@@ -39,10 +42,10 @@ private:
         DirectedGraph<T> transposed;
         auto vertices = GetVertices();
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            size_t vertex = vertices->Get(i);
+            size_t vertex = vertices->UncheckedGet(i);
             auto edges = GetEdges(vertex);
             for (size_t j = 0; j < edges->GetLength(); ++j) {
-                transposed.AddEdge(edges->Get(j).first, vertex, edges->Get(j).second);
+                transposed.AddEdge(edges->UncheckedGet(j).first, vertex, edges->UncheckedGet(j).second);
             }
         }
         return transposed;
@@ -55,6 +58,44 @@ public:
         }
     }
 
+    // Для массовой загрузки: таблица смежности сразу рассчитана на expectedDegree рёбер
+    void AddVertex(size_t vertex, size_t expectedDegree) {
+        if (!adjList.ContainsKey(vertex)) {
+            HashTableDictionary<size_t, T> edges;
+            edges.Reserve(expectedDegree);
+            adjList.Add(vertex, edges);
+        } else {
+            adjList.Get(vertex).Reserve(expectedDegree);
+        }
+    }
+
+    void ReserveVertices(size_t vertexCount) {
+        adjList.Reserve(vertexCount);
+    }
+
+    size_t GetVertexCount() const {
+        return adjList.GetCount();
+    }
+
+    void AddVertices(const ArraySequence<size_t>& batch) {
+        adjList.Reserve(adjList.GetCount() + batch.GetLength());
+        for (size_t vertex : batch) {
+            AddVertex(vertex);
+        }
+    }
+
+    // Результат тот же, что у AddEdge для каждого ребра по порядку, но таблицы выделяются один раз (см. GraphBatch.h)
+    void AddEdges(const GraphEdge<T>* batch, size_t count, ExecutionPolicy policy = ExecutionPolicy::Sequential,
+                  ThreadPool& pool = ThreadPool::Instance()) {
+        DynamicArray<GraphEdge<T>> arcs(batch, count);
+        InsertArcs(adjList, arcs, true, policy, pool);
+    }
+
+    void AddEdges(const ArraySequence<GraphEdge<T>>& batch, ExecutionPolicy policy = ExecutionPolicy::Sequential,
+                  ThreadPool& pool = ThreadPool::Instance()) {
+        AddEdges(batch.Data(), batch.GetLength(), policy, pool);
+    }
+
     void AddEdge(size_t from, size_t to, T weight) override {
         AddVertex(from);
         AddVertex(to);
@@ -63,7 +104,7 @@ public:
 
     ShrdPtr<ArraySequence<size_t>> GetVertices() const override {
         auto vertices = adjList.GetAllItems();
-        auto result = ShrdPtr<ArraySequence<size_t>>(new ArraySequence<size_t>());
+        auto result = MakeShrd<ArraySequence<size_t>>();
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
             result->Add(vertices->Get(i).first);
         }
@@ -75,7 +116,7 @@ public:
             throw std::out_of_range("Vertex not found");
         }
         auto edges = adjList.Get(vertex).GetAllItems();
-        auto result = ShrdPtr<ArraySequence<std::pair<size_t, T>>>(new ArraySequence<std::pair<size_t, T>>());
+        auto result = MakeShrd<ArraySequence<std::pair<size_t, T>>>();
         for (size_t i = 0; i < edges->GetLength(); ++i) {
             result->Add(edges->Get(i));
         }
@@ -83,12 +124,14 @@ public:
     }
 
     ShrdPtr<ArraySequence<T>> ShortestPaths(size_t start) const override {
-        HashTableDictionary<size_t, T> distances;
+        auto vertices = GetVertices();
+        // Таблица расстояний живёт только во время запроса: вся её память берётся из арены
+        Arena scratch;
+        HashTableDictionary<size_t, T> distances(vertices->GetLength() * 2 + 1, &scratch);
         PriorityQueue<size_t, T> queue;
 
-        auto vertices = GetVertices();
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            distances.Add(vertices->Get(i), std::numeric_limits<T>::max());
+            distances.Add(vertices->UncheckedGet(i), std::numeric_limits<T>::max());
         }
 
         distances.Get(start) = 0;
@@ -99,8 +142,8 @@ public:
             auto edges = GetEdges(current);
 
             for (size_t i = 0; i < edges->GetLength(); ++i) {
-                size_t neighbor = edges->Get(i).first;
-                T weight = edges->Get(i).second;
+                size_t neighbor = edges->UncheckedGet(i).first;
+                T weight = edges->UncheckedGet(i).second;
 
                 T newDistance = distances.Get(current) + weight;
                 if (newDistance < distances.Get(neighbor)) {
@@ -110,9 +153,9 @@ public:
             }
         }
 
-        auto result = ShrdPtr<ArraySequence<T>>(new ArraySequence<T>());
+        auto result = MakeShrd<ArraySequence<T>>();
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            result->Add(distances.Get(vertices->Get(i)));
+            result->Add(distances.Get(vertices->UncheckedGet(i)));
         }
 
         return result;
@@ -123,11 +166,11 @@ public:
         auto vertices = GetVertices();
 
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            if (vertices->Get(i) == end) {
-                if (distances->Get(i) == std::numeric_limits<T>::max()) {
+            if (vertices->UncheckedGet(i) == end) {
+                if (distances->UncheckedGet(i) == std::numeric_limits<T>::max()) {
                     throw std::runtime_error("There is no path from start to end vertex.");
                 }
-                return distances->Get(i);
+                return distances->UncheckedGet(i);
             }
         }
         throw std::out_of_range("End vertex not found in the graph");
@@ -137,26 +180,26 @@ public:
         auto vertices = GetVertices();
         HashTableDictionary<size_t, bool> visited;
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            visited.Add(vertices->Get(i), false);
+            visited.Add(vertices->UncheckedGet(i), false);
         }
 
-        auto stack = ShrdPtr<ArraySequence<size_t>>(new ArraySequence<size_t>());
+        auto stack = MakeShrd<ArraySequence<size_t>>();
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            if (!visited.Get(vertices->Get(i))) {
-                FillOrder(vertices->Get(i), visited, stack);
+            if (!visited.Get(vertices->UncheckedGet(i))) {
+                FillOrder(vertices->UncheckedGet(i), visited, stack);
             }
         }
 
         DirectedGraph<T> transposed = GetTransposed();
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            visited.Get(vertices->Get(i)) = false;
+            visited.Get(vertices->UncheckedGet(i)) = false;
         }
 
-        auto components = ShrdPtr<ArraySequence<ShrdPtr<ArraySequence<size_t>>>>(new ArraySequence<ShrdPtr<ArraySequence<size_t>>>());
+        auto components = MakeShrd<ArraySequence<ShrdPtr<ArraySequence<size_t>>>>();
         for (int i = stack->GetLength() - 1; i >= 0; --i) {
-            size_t vertex = stack->Get(i);
+            size_t vertex = stack->UncheckedGet(i);
             if (!visited.Get(vertex)) {
-                auto component = ShrdPtr<ArraySequence<size_t>>(new ArraySequence<size_t>());
+                auto component = MakeShrd<ArraySequence<size_t>>();
                 transposed.DFS(vertex, visited, component);
                 components->Add(component);
             }
@@ -169,13 +212,13 @@ public:
         auto vertices = GetVertices();
         HashTableDictionary<size_t, bool> visited;
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            visited.Add(vertices->Get(i), false);
+            visited.Add(vertices->UncheckedGet(i), false);
         }
 
-        auto stack = ShrdPtr<ArraySequence<size_t>>(new ArraySequence<size_t>());
+        auto stack = MakeShrd<ArraySequence<size_t>>();
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            if (!visited.Get(vertices->Get(i))) {
-                FillOrder(vertices->Get(i), visited, stack);
+            if (!visited.Get(vertices->UncheckedGet(i))) {
+                FillOrder(vertices->UncheckedGet(i), visited, stack);
             }
         }
 
@@ -190,6 +233,14 @@ public:
         return FindStronglyConnectedComponents();
     }
 
+    // Двоичный CSR-файл, который открывается через MappedGraph без разбора
+    void Save(const std::string& path) const {
+        SaveGraph(*this, path, true);
+    }
+
+    size_t MemoryUsage() const override {
+        return sizeof(*this) - sizeof(adjList) + adjList.MemoryUsage();
+    }
 };
 
 #endif // DIRECTEDGRAPH_H
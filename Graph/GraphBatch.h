@@ -0,0 +1,92 @@
+#ifndef GRAPHBATCH_H
+#define GRAPHBATCH_H
+
+#include "IGraph.h"
+#include "HashTableDictionary.h"
+#include "DynamicArray.h"
+#include "RadixSort.h"
+#include "SequenceOperations.h"
+
+// Пакетная вставка дуг в таблицы смежности графа. Дуги устойчиво сортируются по началу, поэтому
+// из повторяющихся дуг, как и при AddEdge, остаётся последняя. Затем по группам одного начала
+// каждая таблица смежности один раз получает итоговый размер, и внешняя таблица проверяется
+// один раз на вершину, а не на ребро. Группы касаются разных таблиц, поэтому в режиме Parallel
+// они заполняются в pool без блокировок.
+template <typename T>
+void InsertArcs(HashTableDictionary<size_t, HashTableDictionary<size_t, T>>& adjList, DynamicArray<GraphEdge<T>>& arcs,
+                bool addTargets, ExecutionPolicy policy, ThreadPool& pool = ThreadPool::Instance()) {
+    size_t n = arcs.GetSize();
+    if (n == 0) {
+        return;
+    }
+    RadixSortRange(arcs.Data(), n, [](const GraphEdge<T>& arc) { return arc.from; });
+
+    DynamicArray<size_t> groups;
+    for (size_t i = 0; i < n; ++i) {
+        if (i == 0 || arcs.UncheckedGet(i).from != arcs.UncheckedGet(i - 1).from) {
+            groups.PushBack(i);
+        }
+    }
+    size_t groupCount = groups.GetSize();
+    groups.PushBack(n);
+
+    DynamicArray<size_t> targets;
+    if (addTargets) {
+        targets.Reserve(n);
+        for (const GraphEdge<T>& arc : arcs) {
+            targets.PushBack(arc.to);
+        }
+        RadixSortRange(targets.Data(), n, RadixIdentity());
+        size_t unique = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (i == 0 || targets.UncheckedGet(i) != targets.UncheckedGet(unique - 1)) {
+                targets.UncheckedGet(unique++) = targets.UncheckedGet(i);
+            }
+        }
+        targets.Resize(unique);
+    }
+
+    // Внешняя таблица расширяется один раз: на число различных вершин пакета (начала и концы без повторов)
+    size_t touched = groupCount;
+    for (size_t i = 0, group = 0; i < targets.GetSize(); ++i) {
+        size_t vertex = targets.UncheckedGet(i);
+        while (group < groupCount && arcs.UncheckedGet(groups.UncheckedGet(group)).from < vertex) {
+            ++group;
+        }
+        if (group == groupCount || arcs.UncheckedGet(groups.UncheckedGet(group)).from != vertex) {
+            ++touched;
+        }
+    }
+    adjList.Reserve(adjList.GetCount() + touched);
+    for (size_t group = 0; group < groupCount; ++group) {
+        size_t vertex = arcs.UncheckedGet(groups.UncheckedGet(group)).from;
+        size_t degree = groups.UncheckedGet(group + 1) - groups.UncheckedGet(group);
+        if (adjList.ContainsKey(vertex)) {
+            HashTableDictionary<size_t, T>& edges = adjList.Get(vertex);
+            edges.Reserve(edges.GetCount() + degree);
+        } else {
+            // Новая таблица сразу нужной ёмкости переносится во внешнюю без копирования
+            HashTableDictionary<size_t, T> edges(HashTableDictionary<size_t, T>::CapacityFor(degree));
+            adjList.Add(vertex, std::move(edges));
+        }
+    }
+    for (size_t vertex : targets) {
+        if (!adjList.ContainsKey(vertex)) {
+            adjList.Add(vertex, HashTableDictionary<size_t, T>());
+        }
+    }
+
+    const GraphEdge<T>* data = arcs.Data();
+    const size_t* starts = groups.Data();
+    auto fill = [&adjList, data, starts](size_t from, size_t to) {
+        for (size_t group = from; group < to; ++group) {
+            HashTableDictionary<size_t, T>& edges = adjList.Get(data[starts[group]].from);
+            for (size_t i = starts[group]; i < starts[group + 1]; ++i) {
+                edges.Add(data[i].to, data[i].weight);
+            }
+        }
+    };
+    RunChunked(groupCount, policy, fill, pool);
+}
+
+#endif //GRAPHBATCH_H
@@ -0,0 +1,139 @@
+#ifndef GRAPHFILE_H
+#define GRAPHFILE_H
+
+#include "IGraph.h"
+#include "HashTableDictionary.h"
+#include "DynamicArray.h"
+#include "QuickSort.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Двоичный формат графа (CSR). После заголовка GraphFileHeader идут массивы, каждый выровнен на 64 байта:
+//   ids      uint64_t[vertexCount]      — идентификаторы вершин в порядке GetVertices
+//   idOrder  uint64_t[vertexCount]      — плотные индексы, упорядоченные по идентификатору (поиск вершины)
+//   offsets  uint64_t[vertexCount + 1]  — рёбра вершины i занимают [offsets[i], offsets[i + 1])
+//   targets  uint64_t[edgeCount]        — плотные индексы концов рёбер
+//   weights  T[edgeCount]
+// Неориентированный граф хранит каждое ребро в обе стороны, как и его таблицы смежности.
+// Файл читается MappedGraph без разбора: запросы идут прямо по отображённым массивам.
+
+struct GraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t weightSize;
+    uint32_t weightKind;
+    uint64_t vertexCount;
+    uint64_t edgeCount;
+    uint64_t idsOffset;
+    uint64_t idOrderOffset;
+    uint64_t offsetsOffset;
+    uint64_t targetsOffset;
+    uint64_t weightsOffset;
+    uint64_t fileSize;
+    uint8_t reserved[40];
+};
+static_assert(sizeof(GraphFileHeader) == 128, "GraphFileHeader must stay 128 bytes");
+
+constexpr char GraphFileMagic[8] = {'L', '4', 'G', 'R', 'A', 'P', 'H', '\0'};
+constexpr uint32_t GraphFileVersion = 1;
+constexpr uint32_t GraphFileDirected = 1;
+constexpr uint64_t GraphFileAlignment = 64;
+
+// Вид веса, чтобы файл с int не открылся как граф с float того же размера
+template <typename T>
+constexpr uint32_t GraphWeightKind() {
+    return std::is_floating_point<T>::value ? 3 : std::is_signed<T>::value ? 2 : std::is_integral<T>::value ? 1 : 0;
+}
+
+inline uint64_t AlignGraphOffset(uint64_t offset) {
+    return (offset + GraphFileAlignment - 1) / GraphFileAlignment * GraphFileAlignment;
+}
+
+// Файл пишется во временный path + ".tmp" и переименовывается, поэтому читатели не увидят недописанный граф
+template <typename T>
+void SaveGraph(const IGraph<T>& graph, const std::string& path, bool directed) {
+    static_assert(std::is_trivially_copyable<T>::value, "SaveGraph requires a trivially copyable weight type");
+
+    auto vertices = graph.GetVertices();
+    size_t vertexCount = vertices->GetLength();
+    HashTableDictionary<size_t, size_t> indices(vertexCount * 2 + 1);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        indices.Add(vertices->UncheckedGet(i), i);
+    }
+
+    DynamicArray<uint64_t> ids(vertexCount);
+    DynamicArray<uint64_t> idOrder(vertexCount);
+    DynamicArray<uint64_t> offsets(vertexCount + 1);
+    DynamicArray<uint64_t> targets;
+    DynamicArray<T> weights;
+    offsets.UncheckedGet(0) = 0;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        ids.UncheckedGet(i) = vertices->UncheckedGet(i);
+        idOrder.UncheckedGet(i) = i;
+        auto edges = graph.GetEdges(vertices->UncheckedGet(i));
+        for (size_t j = 0; j < edges->GetLength(); ++j) {
+            targets.PushBack(indices.Get(edges->UncheckedGet(j).first));
+            weights.PushBack(edges->UncheckedGet(j).second);
+        }
+        offsets.UncheckedGet(i + 1) = targets.GetSize();
+    }
+    const uint64_t* idData = ids.Data();
+    auto byId = [idData](uint64_t a, uint64_t b) { return idData[a] < idData[b]; };
+    IntroSort(idOrder.Data(), vertexCount, byId);
+
+    GraphFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, GraphFileMagic, sizeof(GraphFileMagic));
+    header.version = GraphFileVersion;
+    header.flags = directed ? GraphFileDirected : 0;
+    header.weightSize = sizeof(T);
+    header.weightKind = GraphWeightKind<T>();
+    header.vertexCount = vertexCount;
+    header.edgeCount = targets.GetSize();
+    header.idsOffset = AlignGraphOffset(sizeof(GraphFileHeader));
+    header.idOrderOffset = AlignGraphOffset(header.idsOffset + vertexCount * sizeof(uint64_t));
+    header.offsetsOffset = AlignGraphOffset(header.idOrderOffset + vertexCount * sizeof(uint64_t));
+    header.targetsOffset = AlignGraphOffset(header.offsetsOffset + (vertexCount + 1) * sizeof(uint64_t));
+    header.weightsOffset = AlignGraphOffset(header.targetsOffset + header.edgeCount * sizeof(uint64_t));
+    header.fileSize = header.weightsOffset + header.edgeCount * sizeof(T);
+
+    std::string temporary = path + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("open " + temporary + ": " + std::strerror(errno));
+    }
+    uint64_t written = 0;
+    bool ok = true;
+    auto write = [file, &written, &ok](uint64_t offset, const void* data, uint64_t bytes) {
+        static const char padding[GraphFileAlignment] = {};
+        if (ok && offset > written) {
+            ok = std::fwrite(padding, 1, offset - written, file) == offset - written;
+        }
+        if (ok && bytes > 0) {
+            ok = std::fwrite(data, 1, bytes, file) == bytes;
+        }
+        written = offset + bytes;
+    };
+    write(0, &header, sizeof(header));
+    write(header.idsOffset, ids.Data(), vertexCount * sizeof(uint64_t));
+    write(header.idOrderOffset, idOrder.Data(), vertexCount * sizeof(uint64_t));
+    write(header.offsetsOffset, offsets.Data(), (vertexCount + 1) * sizeof(uint64_t));
+    write(header.targetsOffset, targets.Data(), header.edgeCount * sizeof(uint64_t));
+    write(header.weightsOffset, weights.Data(), header.edgeCount * sizeof(T));
+    if (std::fclose(file) != 0 || !ok) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("write " + temporary + ": " + std::strerror(errno));
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("rename " + temporary + ": " + std::strerror(errno));
+    }
+}
+
+#endif //GRAPHFILE_H
@@ -0,0 +1,440 @@
+#ifndef GRAPHGENERATORS_H
+#define GRAPHGENERATORS_H
+
+#include "DirectedGraph.h"
+#include "UndirectedGraph.h"
+#include "DynamicArray.h"
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Детерминированные генераторы графов для тестов и бенчмарков. При одинаковом seed рёбра получаются
+// одни и те же на любой платформе: используется только std::mt19937_64 (его выход задан стандартом),
+// а распределения std::*_distribution, зависящие от реализации, заменены своими.
+// Каждый генератор выдаёт поток рёбер в Generate(sink), собирает их в Edges() или заполняет граф
+// через Fill (пакетами AddEdges, без хранения всего потока).
+
+class GraphRandom {
+public:
+    explicit GraphRandom(uint64_t seed) : engine(seed) {}
+
+    uint64_t Next() {
+        return engine();
+    }
+
+    // Равномерно в [0, bound)
+    uint64_t Below(uint64_t bound) {
+        uint64_t limit = UINT64_MAX - UINT64_MAX % bound;
+        uint64_t value;
+        do {
+            value = engine();
+        } while (value >= limit);
+        return value % bound;
+    }
+
+    // Равномерно в [0, 1)
+    double Uniform() {
+        return static_cast<double>(engine() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    double Exponential(double mean) {
+        return -mean * std::log1p(-Uniform());
+    }
+
+private:
+    std::mt19937_64 engine;
+};
+
+// Распределение весов рёбер. Для целых весов Uniform включает обе границы, Exponential округляется вверх
+template <typename T>
+struct EdgeWeights {
+    enum class Kind {
+        Constant,
+        Uniform,
+        Exponential
+    };
+
+    Kind kind = Kind::Constant;
+    double first = 1;
+    double second = 1;
+
+    static EdgeWeights Constant(T value) {
+        return EdgeWeights{Kind::Constant, static_cast<double>(value), static_cast<double>(value)};
+    }
+
+    static EdgeWeights Uniform(T min, T max) {
+        if (max < min) {
+            throw std::invalid_argument("EdgeWeights::Uniform: max < min");
+        }
+        return EdgeWeights{Kind::Uniform, static_cast<double>(min), static_cast<double>(max)};
+    }
+
+    static EdgeWeights Exponential(double mean) {
+        return EdgeWeights{Kind::Exponential, mean, mean};
+    }
+
+    T Sample(GraphRandom& random) const {
+        switch (kind) {
+            case Kind::Uniform:
+                if constexpr (std::is_integral<T>::value) {
+                    return static_cast<T>(static_cast<T>(first) + static_cast<T>(random.Below(static_cast<uint64_t>(second - first) + 1)));
+                } else {
+                    return static_cast<T>(first + (second - first) * random.Uniform());
+                }
+            case Kind::Exponential:
+                if constexpr (std::is_integral<T>::value) {
+                    return static_cast<T>(std::ceil(random.Exponential(first)));
+                } else {
+                    return static_cast<T>(random.Exponential(first));
+                }
+            default:
+                return static_cast<T>(first);
+        }
+    }
+};
+
+// Основа генераторов: Derived::Generate(sink) вызывает sink(const GraphEdge<T>&) для каждого ребра,
+// Derived::VertexCount() — число вершин, их номера 0..VertexCount()-1.
+// Derived::IsSymmetric() — рёбра описывают неориентированные связи (сетка, Барабаши — Альберт),
+// тогда ориентированный граф получает дуги в обе стороны
+template <typename Derived, typename T>
+class GraphGenerator {
+public:
+    // Рёбер в одном вызове AddEdges при Fill: ограничивает память под поток рёбер
+    static constexpr size_t DefaultBatchSize = size_t(1) << 20;
+
+    DynamicArray<GraphEdge<T>> Edges() const {
+        DynamicArray<GraphEdge<T>> edges;
+        derived().Generate([&edges](const GraphEdge<T>& edge) { edges.PushBack(edge); });
+        return edges;
+    }
+
+    void Fill(DirectedGraph<T>& graph, ExecutionPolicy policy = ExecutionPolicy::Sequential,
+              size_t batchSize = DefaultBatchSize) const {
+        bool symmetric = derived().IsSymmetric();
+        fillBatches(graph, policy, batchSize, [symmetric](DynamicArray<GraphEdge<T>>& batch, const GraphEdge<T>& edge) {
+            batch.PushBack(edge);
+            if (symmetric && edge.from != edge.to) {
+                batch.PushBack(GraphEdge<T>{edge.to, edge.from, edge.weight});
+            }
+        });
+    }
+
+    void Fill(UndirectedGraph<T>& graph, ExecutionPolicy policy = ExecutionPolicy::Sequential,
+              size_t batchSize = DefaultBatchSize) const {
+        fillBatches(graph, policy, batchSize, [](DynamicArray<GraphEdge<T>>& batch, const GraphEdge<T>& edge) {
+            batch.PushBack(edge);
+        });
+    }
+
+private:
+    const Derived& derived() const {
+        return static_cast<const Derived&>(*this);
+    }
+
+    // AddEdges по частям даёт тот же граф, что и одним пакетом, но поток рёбер не хранится целиком
+    // Сначала все вершины 0..VertexCount()-1: без рёбер изолированные вершины не попали бы в граф
+    template <typename Graph, typename Push>
+    void fillBatches(Graph& graph, ExecutionPolicy policy, size_t batchSize, Push push) const {
+        size_t vertexCount = derived().VertexCount();
+        ArraySequence<size_t> vertices;
+        vertices.Reserve(vertexCount);
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            vertices.Add(vertex);
+        }
+        graph.AddVertices(vertices);
+
+        DynamicArray<GraphEdge<T>> batch;
+        derived().Generate([&](const GraphEdge<T>& edge) {
+            push(batch, edge);
+            if (batch.GetSize() >= batchSize) {
+                graph.AddEdges(batch.Data(), batch.GetSize(), policy);
+                batch.Clear();
+            }
+        });
+        graph.AddEdges(batch.Data(), batch.GetSize(), policy);
+    }
+};
+
+// G(n, p): каждая пара вершин соединена с вероятностью p. Пары перебираются с геометрическими пропусками
+// (Batagelj, Brandes), поэтому время O(n + m), а не O(n^2). Для directed — упорядоченные пары без петель,
+// иначе пары (v, w) с w < v
+template <typename T>
+class ErdosRenyiGenerator : public GraphGenerator<ErdosRenyiGenerator<T>, T> {
+public:
+    ErdosRenyiGenerator(size_t vertexCount, double probability, uint64_t seed,
+                        EdgeWeights<T> weights = EdgeWeights<T>(), bool directed = true)
+        : vertexCount(vertexCount), probability(probability), seed(seed), weights(weights), directed(directed) {
+        if (probability < 0 || probability > 1) {
+            throw std::invalid_argument("ErdosRenyiGenerator: probability must be in [0, 1]");
+        }
+    }
+
+    size_t VertexCount() const {
+        return vertexCount;
+    }
+
+    bool IsSymmetric() const {
+        return !directed;
+    }
+
+    template <typename Sink>
+    void Generate(Sink sink) const {
+        if (vertexCount < 2 || probability == 0) {
+            return;
+        }
+        GraphRandom random(seed);
+        // Номер пары в строке v: для directed w пробегает все вершины, кроме v, иначе только w < v
+        size_t v = directed ? 0 : 1;
+        size_t w = 0;
+        double logSkip = probability < 1 ? std::log1p(-probability) : 0;
+        while (v < vertexCount) {
+            if (probability < 1) {
+                double skip = std::floor(std::log1p(-random.Uniform()) / logSkip);
+                if (skip >= static_cast<double>(vertexCount) * vertexCount) {
+                    return;
+                }
+                w += static_cast<size_t>(skip);
+            }
+            for (size_t row = rowLength(v); w >= row && v < vertexCount; row = rowLength(v)) {
+                w -= row;
+                ++v;
+            }
+            if (v >= vertexCount) {
+                return;
+            }
+            size_t to = directed && w >= v ? w + 1 : w;
+            sink(GraphEdge<T>{v, to, weights.Sample(random)});
+            ++w;
+        }
+    }
+
+private:
+    size_t vertexCount;
+    double probability;
+    uint64_t seed;
+    EdgeWeights<T> weights;
+    bool directed;
+
+    size_t rowLength(size_t v) const {
+        return directed ? vertexCount - 1 : v;
+    }
+};
+
+// R-MAT (рекурсивная матрица, частный случай графа Кронекера): 2^scale вершин, edgeFactor * 2^scale дуг.
+// Каждая дуга выбирает квадрант матрицы смежности с вероятностями a, b, c, 1 - a - b - c на каждом
+// из scale уровней; по умолчанию параметры Graph500. Степени распределены по степенному закону,
+// повторы дуг и петли возможны, как и в оригинальной модели
+template <typename T>
+class RmatGenerator : public GraphGenerator<RmatGenerator<T>, T> {
+public:
+    RmatGenerator(size_t scale, size_t edgeFactor, uint64_t seed, EdgeWeights<T> weights = EdgeWeights<T>(),
+                  double a = 0.57, double b = 0.19, double c = 0.19)
+        : scale(scale), edgeFactor(edgeFactor), seed(seed), weights(weights), a(a), b(b), c(c) {
+        if (scale >= 48 || a < 0 || b < 0 || c < 0 || a + b + c > 1) {
+            throw std::invalid_argument("RmatGenerator: invalid parameters");
+        }
+    }
+
+    size_t VertexCount() const {
+        return size_t(1) << scale;
+    }
+
+    bool IsSymmetric() const {
+        return false;
+    }
+
+    template <typename Sink>
+    void Generate(Sink sink) const {
+        GraphRandom random(seed);
+        size_t edgeCount = edgeFactor << scale;
+        for (size_t i = 0; i < edgeCount; ++i) {
+            size_t from = 0;
+            size_t to = 0;
+            for (size_t level = 0; level < scale; ++level) {
+                double r = random.Uniform();
+                from <<= 1;
+                to <<= 1;
+                if (r >= a + b + c) {
+                    from |= 1;
+                    to |= 1;
+                } else if (r >= a + b) {
+                    from |= 1;
+                } else if (r >= a) {
+                    to |= 1;
+                }
+            }
+            sink(GraphEdge<T>{from, to, weights.Sample(random)});
+        }
+    }
+
+private:
+    size_t scale;
+    size_t edgeFactor;
+    uint64_t seed;
+    EdgeWeights<T> weights;
+    double a;
+    double b;
+    double c;
+};
+
+// Дорожная сеть: решётка rows x cols, вершина (r, c) имеет номер r * cols + c. Каждое ребро к соседу
+// справа и снизу остаётся с вероятностью keepProbability (1 — полная решётка)
+template <typename T>
+class GridGenerator : public GraphGenerator<GridGenerator<T>, T> {
+public:
+    GridGenerator(size_t rows, size_t cols, uint64_t seed, EdgeWeights<T> weights = EdgeWeights<T>(),
+                  double keepProbability = 1)
+        : rows(rows), cols(cols), seed(seed), weights(weights), keepProbability(keepProbability) {}
+
+    size_t VertexCount() const {
+        return rows * cols;
+    }
+
+    bool IsSymmetric() const {
+        return true;
+    }
+
+    template <typename Sink>
+    void Generate(Sink sink) const {
+        GraphRandom random(seed);
+        for (size_t r = 0; r < rows; ++r) {
+            for (size_t c = 0; c < cols; ++c) {
+                size_t vertex = r * cols + c;
+                if (c + 1 < cols && (keepProbability >= 1 || random.Uniform() < keepProbability)) {
+                    sink(GraphEdge<T>{vertex, vertex + 1, weights.Sample(random)});
+                }
+                if (r + 1 < rows && (keepProbability >= 1 || random.Uniform() < keepProbability)) {
+                    sink(GraphEdge<T>{vertex, vertex + cols, weights.Sample(random)});
+                }
+            }
+        }
+    }
+
+private:
+    size_t rows;
+    size_t cols;
+    uint64_t seed;
+    EdgeWeights<T> weights;
+    double keepProbability;
+};
+
+// Барабаши — Альберт: начало — полный граф на edgesPerVertex + 1 вершинах, каждая следующая вершина
+// соединяется с edgesPerVertex различными прежними, выбранными пропорционально степени. Рёбра идут
+// от новой вершины к старой, граф связен
+template <typename T>
+class BarabasiAlbertGenerator : public GraphGenerator<BarabasiAlbertGenerator<T>, T> {
+public:
+    BarabasiAlbertGenerator(size_t vertexCount, size_t edgesPerVertex, uint64_t seed,
+                            EdgeWeights<T> weights = EdgeWeights<T>())
+        : vertexCount(vertexCount), edgesPerVertex(edgesPerVertex), seed(seed), weights(weights) {
+        if (edgesPerVertex == 0) {
+            throw std::invalid_argument("BarabasiAlbertGenerator: edgesPerVertex must be positive");
+        }
+    }
+
+    size_t VertexCount() const {
+        return vertexCount;
+    }
+
+    bool IsSymmetric() const {
+        return true;
+    }
+
+    template <typename Sink>
+    void Generate(Sink sink) const {
+        GraphRandom random(seed);
+        size_t m = edgesPerVertex;
+        size_t initial = vertexCount < m + 1 ? vertexCount : m + 1;
+        // Каждая вершина встречается здесь столько раз, какова её степень
+        DynamicArray<size_t> endpoints;
+        endpoints.Reserve(vertexCount > initial ? 2 * m * vertexCount : initial * initial);
+        for (size_t v = 1; v < initial; ++v) {
+            for (size_t w = 0; w < v; ++w) {
+                sink(GraphEdge<T>{v, w, weights.Sample(random)});
+                endpoints.PushBack(v);
+                endpoints.PushBack(w);
+            }
+        }
+        DynamicArray<size_t> chosen(m);
+        for (size_t v = initial; v < vertexCount; ++v) {
+            for (size_t i = 0; i < m; ++i) {
+                size_t target;
+                bool repeated;
+                do {
+                    target = endpoints.UncheckedGet(random.Below(endpoints.GetSize()));
+                    repeated = false;
+                    for (size_t j = 0; j < i && !repeated; ++j) {
+                        repeated = chosen.UncheckedGet(j) == target;
+                    }
+                } while (repeated);
+                chosen.UncheckedGet(i) = target;
+            }
+            for (size_t i = 0; i < m; ++i) {
+                sink(GraphEdge<T>{v, chosen.UncheckedGet(i), weights.Sample(random)});
+                endpoints.PushBack(v);
+                endpoints.PushBack(chosen.UncheckedGet(i));
+            }
+        }
+    }
+
+private:
+    size_t vertexCount;
+    size_t edgesPerVertex;
+    uint64_t seed;
+    EdgeWeights<T> weights;
+};
+
+// Ациклический граф: вершины получают случайный топологический порядок (перестановка по seed), и каждая
+// из edgeCount дуг соединяет две различные вершины от меньшего ранга к большему. Повторы дуг возможны
+template <typename T>
+class DagGenerator : public GraphGenerator<DagGenerator<T>, T> {
+public:
+    DagGenerator(size_t vertexCount, size_t edgeCount, uint64_t seed, EdgeWeights<T> weights = EdgeWeights<T>())
+        : vertexCount(vertexCount), edgeCount(edgeCount), seed(seed), weights(weights) {}
+
+    size_t VertexCount() const {
+        return vertexCount;
+    }
+
+    bool IsSymmetric() const {
+        return false;
+    }
+
+    template <typename Sink>
+    void Generate(Sink sink) const {
+        if (vertexCount < 2) {
+            return;
+        }
+        GraphRandom random(seed);
+        DynamicArray<size_t> order(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            order.UncheckedGet(i) = i;
+        }
+        for (size_t i = vertexCount - 1; i > 0; --i) {
+            std::swap(order.UncheckedGet(i), order.UncheckedGet(random.Below(i + 1)));
+        }
+        for (size_t i = 0; i < edgeCount; ++i) {
+            size_t first = random.Below(vertexCount);
+            size_t second = random.Below(vertexCount - 1);
+            if (second >= first) {
+                ++second;
+            }
+            if (first > second) {
+                std::swap(first, second);
+            }
+            sink(GraphEdge<T>{order.UncheckedGet(first), order.UncheckedGet(second), weights.Sample(random)});
+        }
+    }
+
+private:
+    size_t vertexCount;
+    size_t edgeCount;
+    uint64_t seed;
+    EdgeWeights<T> weights;
+};
+
+#endif //GRAPHGENERATORS_H
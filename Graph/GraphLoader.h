@@ -0,0 +1,504 @@
+#ifndef GRAPHLOADER_H
+#define GRAPHLOADER_H
+
+#ifdef _WIN32
+#error "GraphLoader requires POSIX mmap"
+#endif
+
+#include "DirectedGraph.h"
+#include "UndirectedGraph.h"
+#include "DynamicArray.h"
+#include "ThreadPool.h"
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Загрузка графов из текстовых файлов:
+//   EdgeList     — «u v [w]» в строке, комментарии с '#' или '%' (SNAP);
+//   Dimacs       — «p sp n m», дуги «a u v w», комментарии «c» (.gr);
+//   MatrixMarket — «%%MatrixMarket matrix coordinate <field> <symmetry>», строка размеров, затем «i j [v]» (.mtx).
+// Файл отображается в память, область данных делится на куски по границам строк, куски разбираются
+// параллельно. Идентификаторы вершин сохраняются как в файле (у DIMACS и MTX они с единицы).
+// Рёбра без веса получают вес 1.
+
+enum class GraphFileFormat {
+    Auto,
+    EdgeList,
+    Dimacs,
+    MatrixMarket
+};
+
+// Рёбра файла в порядке следования. symmetric — у MTX с симметрией «symmetric»/«hermitian» хранится
+// только одна половина матрицы; ориентированный граф получает при построении и обратные дуги.
+// skew — симметрия «skew-symmetric»: обратная дуга получает вес с обратным знаком.
+// sized — у DIMACS и MTX число вершин vertexCount задано заголовком, вершины 1..vertexCount
+template <typename T>
+struct ParsedGraph {
+    DynamicArray<GraphEdge<T>> edges;
+    bool sized = false;
+    size_t vertexCount = 0;
+    bool symmetric = false;
+    bool skew = false;
+    size_t bytes = 0;
+};
+
+struct GraphLoadStats {
+    size_t bytes = 0;
+    size_t edges = 0;
+    size_t vertices = 0;
+    double parseSeconds = 0;
+    double buildSeconds = 0;
+
+    double MegabytesPerSecond() const {
+        double seconds = parseSeconds + buildSeconds;
+        return seconds > 0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0;
+    }
+};
+
+// Отображение файла только для чтения; пустой файл не отображается
+class MappedTextFile {
+private:
+    std::string path;
+    void* mapping;
+    size_t length;
+
+public:
+    explicit MappedTextFile(const std::string& path) : path(path), mapping(nullptr), length(0) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("open " + path + ": " + std::strerror(errno));
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::runtime_error("fstat " + path + ": " + std::strerror(error));
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) {
+            void* result = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (result == MAP_FAILED) {
+                int error = errno;
+                ::close(fd);
+                throw std::runtime_error("mmap " + path + ": " + std::strerror(error));
+            }
+            mapping = result;
+            madvise(mapping, length, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    MappedTextFile(const MappedTextFile&) = delete;
+    MappedTextFile& operator=(const MappedTextFile&) = delete;
+
+    ~MappedTextFile() {
+        if (mapping) {
+            munmap(mapping, length);
+        }
+    }
+
+    const char* Begin() const { return static_cast<const char*>(mapping); }
+    const char* End() const { return Begin() + length; }
+    size_t GetLength() const { return length; }
+    const std::string& GetPath() const { return path; }
+};
+
+class EdgeTextParser {
+private:
+    const char* cursor;
+    const char* end;
+
+public:
+    EdgeTextParser(const char* begin, const char* end) : cursor(begin), end(end) {}
+
+    const char* GetCursor() const { return cursor; }
+    bool AtEnd() const { return cursor == end; }
+
+    void SkipBlanks() {
+        while (cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+            ++cursor;
+        }
+    }
+
+    // Переходит на начало следующей строки
+    void SkipLine() {
+        const void* newline = std::memchr(cursor, '\n', static_cast<size_t>(end - cursor));
+        cursor = newline ? static_cast<const char*>(newline) + 1 : end;
+    }
+
+    bool AtLineEnd() {
+        SkipBlanks();
+        return cursor == end || *cursor == '\n';
+    }
+
+    char Peek() const { return *cursor; }
+    void Advance() { ++cursor; }
+
+    bool ParseUnsigned(size_t& value) {
+        SkipBlanks();
+        const char* start = cursor;
+        size_t result = 0;
+        while (cursor != end && static_cast<unsigned char>(*cursor - '0') < 10) {
+            size_t digit = static_cast<size_t>(*cursor - '0');
+            // Число не помещается в size_t — строка считается испорченной
+            if (result > (SIZE_MAX - digit) / 10) {
+                return false;
+            }
+            result = result * 10 + digit;
+            ++cursor;
+        }
+        value = result;
+        return cursor != start;
+    }
+
+    template <typename T>
+    bool ParseWeight(T& value) {
+        SkipBlanks();
+        if constexpr (std::is_integral<T>::value) {
+            bool negative = cursor != end && *cursor == '-';
+            if (negative || (cursor != end && *cursor == '+')) {
+                ++cursor;
+            }
+            size_t magnitude = 0;
+            if (!ParseUnsigned(magnitude)) {
+                return false;
+            }
+            value = negative ? static_cast<T>(0 - magnitude) : static_cast<T>(magnitude);
+            return true;
+        } else {
+            if (cursor != end && *cursor == '+') {
+                ++cursor;
+            }
+            std::from_chars_result result = std::from_chars(cursor, end, value);
+            if (result.ec != std::errc()) {
+                return false;
+            }
+            cursor = result.ptr;
+            return true;
+        }
+    }
+};
+
+namespace GraphLoaderDetail {
+
+struct Layout {
+    GraphFileFormat format = GraphFileFormat::EdgeList;
+    const char* dataBegin = nullptr;
+    // sized — размеры взяты из заголовка (строка «p» у DIMACS, строка размеров у MTX)
+    bool sized = false;
+    size_t expectedVertices = 0;
+    size_t expectedEdges = 0;
+    bool symmetric = false;
+    bool skew = false;
+    bool weighted = true;
+};
+
+inline bool EndsWith(const std::string& text, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+inline bool StartsWith(const char* begin, const char* end, const char* prefix) {
+    size_t length = std::strlen(prefix);
+    return static_cast<size_t>(end - begin) >= length && std::memcmp(begin, prefix, length) == 0;
+}
+
+inline std::runtime_error Malformed(const MappedTextFile& file, const char* position) {
+    return std::runtime_error("Malformed graph line at byte " + std::to_string(position - file.Begin()) + " in " +
+                              file.GetPath());
+}
+
+// Заголовок разбирается последовательно: комментарии, «p sp n m» у DIMACS, баннер и строка размеров у MTX
+inline Layout ReadLayout(const MappedTextFile& file, GraphFileFormat format) {
+    Layout layout;
+    if (format == GraphFileFormat::Auto) {
+        const std::string& path = file.GetPath();
+        if (EndsWith(path, ".gr") || EndsWith(path, ".dimacs")) {
+            format = GraphFileFormat::Dimacs;
+        } else if (EndsWith(path, ".mtx") || StartsWith(file.Begin(), file.End(), "%%MatrixMarket")) {
+            format = GraphFileFormat::MatrixMarket;
+        } else {
+            format = GraphFileFormat::EdgeList;
+        }
+    }
+    layout.format = format;
+    layout.dataBegin = file.Begin();
+    if (format == GraphFileFormat::EdgeList) {
+        return layout;
+    }
+
+    EdgeTextParser parser(file.Begin(), file.End());
+    if (format == GraphFileFormat::MatrixMarket) {
+        const char* banner = parser.GetCursor();
+        if (!StartsWith(banner, file.End(), "%%MatrixMarket")) {
+            throw std::runtime_error("Missing %%MatrixMarket banner in " + file.GetPath());
+        }
+        parser.SkipLine();
+        // «%%MatrixMarket matrix coordinate <field> <symmetry>»: поля сравниваются целиком и без учёта регистра,
+        // иначе «skew-symmetric» совпал бы с «symmetric»
+        DynamicArray<std::string> fields;
+        for (const char* cursor = banner; cursor != parser.GetCursor();) {
+            if (std::isspace(static_cast<unsigned char>(*cursor))) {
+                ++cursor;
+                continue;
+            }
+            std::string field;
+            for (; cursor != parser.GetCursor() && !std::isspace(static_cast<unsigned char>(*cursor)); ++cursor) {
+                field.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(*cursor))));
+            }
+            fields.PushBack(std::move(field));
+        }
+        if (fields.GetSize() != 5 || fields.UncheckedGet(1) != "matrix") {
+            throw std::runtime_error("Malformed %%MatrixMarket banner in " + file.GetPath());
+        }
+        if (fields.UncheckedGet(2) != "coordinate") {
+            throw std::runtime_error("Only coordinate Matrix Market files describe graphs: " + file.GetPath());
+        }
+        const std::string& symmetry = fields.UncheckedGet(4);
+        if (symmetry != "general" && symmetry != "symmetric" && symmetry != "hermitian" && symmetry != "skew-symmetric") {
+            throw std::runtime_error("Unknown Matrix Market symmetry '" + symmetry + "' in " + file.GetPath());
+        }
+        layout.weighted = fields.UncheckedGet(3) != "pattern";
+        layout.symmetric = symmetry != "general";
+        layout.skew = symmetry == "skew-symmetric";
+        while (!parser.AtEnd() && (parser.AtLineEnd() || parser.Peek() == '%')) {
+            parser.SkipLine();
+        }
+        size_t rows = 0;
+        size_t columns = 0;
+        if (!parser.ParseUnsigned(rows) || !parser.ParseUnsigned(columns) || !parser.ParseUnsigned(layout.expectedEdges)) {
+            throw Malformed(file, parser.GetCursor());
+        }
+        layout.expectedVertices = rows > columns ? rows : columns;
+        layout.sized = true;
+        parser.SkipLine();
+        layout.dataBegin = parser.GetCursor();
+        return layout;
+    }
+
+    // DIMACS: всё до строки «p» включительно — заголовок
+    while (!parser.AtEnd()) {
+        if (parser.AtLineEnd() || parser.Peek() == 'c') {
+            parser.SkipLine();
+            continue;
+        }
+        if (parser.Peek() != 'p') {
+            break;
+        }
+        parser.Advance();
+        parser.SkipBlanks();
+        while (!parser.AtEnd() && parser.Peek() != ' ' && parser.Peek() != '\t' && parser.Peek() != '\n') {
+            parser.Advance();
+        }
+        if (!parser.ParseUnsigned(layout.expectedVertices) || !parser.ParseUnsigned(layout.expectedEdges)) {
+            throw Malformed(file, parser.GetCursor());
+        }
+        layout.sized = true;
+        parser.SkipLine();
+        break;
+    }
+    layout.dataBegin = parser.GetCursor();
+    return layout;
+}
+
+template <typename T>
+void ParseChunk(const MappedTextFile& file, const Layout& layout, const char* begin, const char* end,
+                DynamicArray<GraphEdge<T>>& edges) {
+    EdgeTextParser parser(begin, end);
+    while (!parser.AtEnd()) {
+        if (parser.AtLineEnd()) {
+            if (!parser.AtEnd()) {
+                parser.Advance();
+            }
+            continue;
+        }
+        char first = parser.Peek();
+        if (first == '#' || first == '%' || (layout.format == GraphFileFormat::Dimacs && first == 'c')) {
+            parser.SkipLine();
+            continue;
+        }
+        if (layout.format == GraphFileFormat::Dimacs) {
+            if (first != 'a') {
+                throw Malformed(file, parser.GetCursor());
+            }
+            parser.Advance();
+        }
+
+        GraphEdge<T> edge{0, 0, T(1)};
+        const char* line = parser.GetCursor();
+        if (!parser.ParseUnsigned(edge.from) || !parser.ParseUnsigned(edge.to)) {
+            throw Malformed(file, line);
+        }
+        // При заданном заголовке вершины нумеруются 1..expectedVertices
+        if (layout.sized && (edge.from == 0 || edge.to == 0 || edge.from > layout.expectedVertices ||
+                             edge.to > layout.expectedVertices)) {
+            throw Malformed(file, line);
+        }
+        if (layout.weighted && !parser.AtLineEnd()) {
+            if (!parser.ParseWeight(edge.weight)) {
+                throw Malformed(file, line);
+            }
+        } else if (layout.format == GraphFileFormat::Dimacs) {
+            throw Malformed(file, line);
+        }
+        edges.PushBack(edge);
+        parser.SkipLine();
+    }
+}
+
+}
+
+// Разбирает файл в массив рёбер. Область данных делится на куски примерно по 4 на поток;
+// граница куска сдвигается на начало следующей строки, поэтому строка целиком достаётся одному куску
+template <typename T>
+ParsedGraph<T> ParseGraphFile(const std::string& path, GraphFileFormat format = GraphFileFormat::Auto,
+                              ThreadPool& pool = ThreadPool::Instance()) {
+    MappedTextFile file(path);
+    ParsedGraph<T> result;
+    result.bytes = file.GetLength();
+    if (file.GetLength() == 0) {
+        return result;
+    }
+    GraphLoaderDetail::Layout layout = GraphLoaderDetail::ReadLayout(file, format);
+    result.symmetric = layout.symmetric;
+    result.skew = layout.skew;
+    result.sized = layout.sized;
+    result.vertexCount = layout.expectedVertices;
+
+    const char* dataBegin = layout.dataBegin;
+    const char* dataEnd = file.End();
+    size_t dataLength = static_cast<size_t>(dataEnd - dataBegin);
+    constexpr size_t minChunk = size_t(1) << 20;
+    size_t chunks = (pool.GetThreadCount() + 1) * 4;
+    if (dataLength / chunks < minChunk) {
+        chunks = dataLength / minChunk + 1;
+    }
+
+    DynamicArray<const char*> bounds(chunks + 1);
+    bounds.UncheckedGet(0) = dataBegin;
+    for (size_t i = 1; i < chunks; ++i) {
+        const char* split = dataBegin + dataLength / chunks * i;
+        if (split < bounds.UncheckedGet(i - 1)) {
+            split = bounds.UncheckedGet(i - 1);
+        }
+        const void* newline = std::memchr(split, '\n', static_cast<size_t>(dataEnd - split));
+        bounds.UncheckedGet(i) = newline ? static_cast<const char*>(newline) + 1 : dataEnd;
+    }
+    bounds.UncheckedGet(chunks) = dataEnd;
+
+    // Грубая оценка длины строки, чтобы куски не перевыделялись на каждом удвоении
+    constexpr size_t bytesPerEdge = 12;
+    DynamicArray<DynamicArray<GraphEdge<T>>> parts(chunks);
+    pool.ParallelFor(0, chunks, 1, [&](size_t from, size_t to) {
+        for (size_t chunk = from; chunk < to; ++chunk) {
+            const char* begin = bounds.UncheckedGet(chunk);
+            const char* end = bounds.UncheckedGet(chunk + 1);
+            DynamicArray<GraphEdge<T>>& part = parts.UncheckedGet(chunk);
+            part.Reserve(static_cast<size_t>(end - begin) / bytesPerEdge + 1);
+            GraphLoaderDetail::ParseChunk(file, layout, begin, end, part);
+        }
+    });
+
+    size_t total = 0;
+    for (const DynamicArray<GraphEdge<T>>& part : parts) {
+        total += part.GetSize();
+    }
+    if (layout.sized && total != layout.expectedEdges) {
+        throw std::runtime_error("Edge count " + std::to_string(total) + " disagrees with header (" +
+                                 std::to_string(layout.expectedEdges) + ") in " + path);
+    }
+    result.edges.Reserve(total);
+    for (const DynamicArray<GraphEdge<T>>& part : parts) {
+        for (const GraphEdge<T>& edge : part) {
+            result.edges.PushBack(edge);
+        }
+    }
+    return result;
+}
+
+template <typename Graph>
+struct GraphTraits;
+
+template <typename T>
+struct GraphTraits<DirectedGraph<T>> {
+    static constexpr bool Directed = true;
+    using Weight = T;
+};
+
+template <typename T>
+struct GraphTraits<UndirectedGraph<T>> {
+    static constexpr bool Directed = false;
+    using Weight = T;
+};
+
+// Строит граф из разобранных рёбер пакетной вставкой AddEdges (см. GraphBatch.h): таблица смежности
+// каждой вершины создаётся один раз, сразу на её степень. Вершины из заголовка без рёбер (изолированные)
+// добавляются после рёбер, чтобы AddEdges не расширял заранее созданные пустые таблицы.
+// Возвращает число вершин графа
+template <typename Graph, typename T>
+size_t BuildGraph(Graph& graph, const ParsedGraph<T>& parsed, ThreadPool& pool = ThreadPool::Instance()) {
+    const DynamicArray<GraphEdge<T>>& edges = parsed.edges;
+    if (parsed.skew) {
+        // Неориентированное ребро не может иметь разный вес в две стороны
+        if (!GraphTraits<Graph>::Directed || !std::is_signed<T>::value) {
+            throw std::runtime_error("Skew-symmetric matrix needs a directed graph with signed weights");
+        }
+    }
+    if (parsed.sized) {
+        graph.ReserveVertices(graph.GetVertexCount() + parsed.vertexCount);
+    }
+    if (GraphTraits<Graph>::Directed && parsed.symmetric) {
+        DynamicArray<GraphEdge<T>> arcs;
+        arcs.Reserve(edges.GetSize() * 2);
+        for (const GraphEdge<T>& edge : edges) {
+            arcs.PushBack(edge);
+            if (edge.from != edge.to) {
+                T weight = edge.weight;
+                if constexpr (std::is_signed<T>::value) {
+                    weight = parsed.skew ? -weight : weight;
+                }
+                arcs.PushBack(GraphEdge<T>{edge.to, edge.from, weight});
+            }
+        }
+        graph.AddEdges(arcs.Data(), arcs.GetSize(), ExecutionPolicy::Parallel, pool);
+    } else {
+        graph.AddEdges(edges.Data(), edges.GetSize(), ExecutionPolicy::Parallel, pool);
+    }
+    if (parsed.sized) {
+        for (size_t vertex = 1; vertex <= parsed.vertexCount; ++vertex) {
+            graph.AddVertex(vertex);
+        }
+    }
+    return graph.GetVertexCount();
+}
+
+// Загружает файл в DirectedGraph<T> или UndirectedGraph<T>; в статистике — объём, время разбора и
+// построения и итоговая скорость в МБ/с
+template <typename Graph>
+GraphLoadStats LoadGraph(const std::string& path, Graph& graph, GraphFileFormat format = GraphFileFormat::Auto,
+                         ThreadPool& pool = ThreadPool::Instance()) {
+    using Clock = std::chrono::steady_clock;
+    GraphLoadStats stats;
+    auto start = Clock::now();
+    ParsedGraph<typename GraphTraits<Graph>::Weight> edges =
+        ParseGraphFile<typename GraphTraits<Graph>::Weight>(path, format, pool);
+    auto parsed = Clock::now();
+    stats.bytes = edges.bytes;
+    stats.edges = edges.edges.GetSize();
+    stats.vertices = BuildGraph(graph, edges, pool);
+    stats.parseSeconds = std::chrono::duration<double>(parsed - start).count();
+    stats.buildSeconds = std::chrono::duration<double>(Clock::now() - parsed).count();
+    return stats;
+}
+
+#endif //GRAPHLOADER_H
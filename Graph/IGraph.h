@@ -5,6 +5,14 @@
 #include <limits>
 #include <stdexcept>
 
+// Ребро для пакетной загрузки (AddEdges, GraphLoader, генераторы)
+template <typename T>
+struct GraphEdge {
+    size_t from;
+    size_t to;
+    T weight;
+};
+
 template <typename T>
 class IGraph {
 public:
@@ -21,6 +29,9 @@ public:
     virtual ShrdPtr<ArraySequence<ShrdPtr<ArraySequence<size_t>>>> FindStronglyConnectedComponents() const = 0;
     virtual ShrdPtr<ArraySequence<size_t>> TopologicalSort() const = 0;
 
+    // Байты, занятые графом вместе со всеми таблицами смежности
+    virtual size_t MemoryUsage() const = 0;
+
     virtual ~IGraph() = default;
 };
 
@@ -0,0 +1,420 @@
+#ifndef MAPPEDGRAPH_H
+#define MAPPEDGRAPH_H
+
+#ifdef _WIN32
+#error "MappedGraph requires POSIX mmap"
+#endif
+
+#include "IGraph.h"
+#include "GraphFile.h"
+#include "PriorityQueue.h"
+#include "ArraySpan.h"
+#include "DynamicArray.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Граф только для чтения поверх файла SaveGraph, отображённого в память. Загрузка — mmap и проверка
+// заголовка, без разбора и копирования: вершины и рёбра читаются прямо из массивов CSR.
+// Вершины внутри адресуются плотными индексами 0..n-1 в порядке GetVertices.
+template <typename T>
+class MappedGraph : public IGraph<T> {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedGraph requires a trivially copyable weight type");
+
+private:
+    std::string path;
+    void* mapping;
+    size_t mappedBytes;
+    bool directed;
+    size_t vertexCount;
+    size_t edgeCount;
+    const uint64_t* ids;
+    const uint64_t* idOrder;
+    const uint64_t* offsets;
+    const uint64_t* targets;
+    const T* weights;
+
+    static void throwSystemError(const std::string& what) {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    void close() {
+        if (mapping) {
+            munmap(mapping, mappedBytes);
+            mapping = nullptr;
+        }
+    }
+
+    template <typename U>
+    const U* section(uint64_t offset, uint64_t count) const {
+        if (offset % alignof(U) != 0 || offset > mappedBytes || count > (mappedBytes - offset) / sizeof(U)) {
+            throw std::runtime_error("Truncated graph file: " + path);
+        }
+        return reinterpret_cast<const U*>(static_cast<const char*>(mapping) + offset);
+    }
+
+    size_t requireIndex(size_t vertex) const {
+        size_t index = FindVertexIndex(vertex);
+        if (index == vertexCount) {
+            throw std::out_of_range("Vertex not found");
+        }
+        return index;
+    }
+
+    // Обход в глубину без рекурсии в том же порядке, что и рекурсивный DFS графов на хеш-таблицах:
+    // enter(v) при входе в вершину, leave(v) после всех её соседей
+    template <typename Enter, typename Leave>
+    void depthFirst(size_t start, const uint64_t* edgeOffsets, const uint64_t* edgeTargets,
+                    DynamicArray<unsigned char>& visited, Enter enter, Leave leave) const {
+        DynamicArray<std::pair<size_t, uint64_t>> stack;
+        visited.UncheckedGet(start) = 1;
+        enter(start);
+        stack.PushBack(std::make_pair(start, edgeOffsets[start]));
+        while (stack.GetSize() > 0) {
+            std::pair<size_t, uint64_t>& top = stack.UncheckedGet(stack.GetSize() - 1);
+            if (top.second == edgeOffsets[top.first + 1]) {
+                leave(top.first);
+                stack.PopBack();
+                continue;
+            }
+            size_t neighbor = edgeTargets[top.second++];
+            if (!visited.UncheckedGet(neighbor)) {
+                visited.UncheckedGet(neighbor) = 1;
+                enter(neighbor);
+                stack.PushBack(std::make_pair(neighbor, edgeOffsets[neighbor]));
+            }
+        }
+    }
+
+    DynamicArray<unsigned char> unvisited() const {
+        DynamicArray<unsigned char> visited(vertexCount);
+        if (vertexCount > 0) {
+            std::memset(visited.Data(), 0, vertexCount);
+        }
+        return visited;
+    }
+
+    ShrdPtr<ArraySequence<size_t>> postOrder() const {
+        DynamicArray<unsigned char> visited = unvisited();
+        auto order = MakeShrd<ArraySequence<size_t>>();
+        order->Reserve(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            if (!visited.UncheckedGet(i)) {
+                depthFirst(i, offsets, targets, visited, [](size_t) {}, [&order](size_t v) { order->Add(v); });
+            }
+        }
+        return order;
+    }
+
+    // Один проход O(V + E) при открытии: дальше запросы читают массивы без проверок, поэтому испорченный
+    // индекс должен быть отвергнут здесь, а не привести к чтению за пределами отображения
+    bool consistent() const {
+        if (offsets[0] != 0 || offsets[vertexCount] != edgeCount) {
+            return false;
+        }
+        for (size_t i = 0; i < vertexCount; ++i) {
+            if (offsets[i] > offsets[i + 1]) {
+                return false;
+            }
+            // Строго возрастающие ids по idOrder заодно означают, что idOrder — перестановка
+            if (idOrder[i] >= vertexCount || (i > 0 && ids[idOrder[i - 1]] >= ids[idOrder[i]])) {
+                return false;
+            }
+        }
+        for (size_t e = 0; e < edgeCount; ++e) {
+            if (targets[e] >= vertexCount) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    explicit MappedGraph(const std::string& path)
+        : path(path), mapping(nullptr), mappedBytes(0), directed(false), vertexCount(0), edgeCount(0),
+          ids(nullptr), idOrder(nullptr), offsets(nullptr), targets(nullptr), weights(nullptr) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throwSystemError("open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            throwSystemError("fstat " + path);
+        }
+        size_t fileSize = static_cast<size_t>(info.st_size);
+        if (fileSize < sizeof(GraphFileHeader)) {
+            ::close(fd);
+            throw std::runtime_error("File is too small to be a graph file: " + path);
+        }
+        void* result = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (result == MAP_FAILED) {
+            throwSystemError("mmap " + path);
+        }
+        mapping = result;
+        mappedBytes = fileSize;
+
+        try {
+            const GraphFileHeader* header = static_cast<const GraphFileHeader*>(mapping);
+            if (std::memcmp(header->magic, GraphFileMagic, sizeof(GraphFileMagic)) != 0 ||
+                header->version != GraphFileVersion) {
+                throw std::runtime_error("File is not a graph file: " + path);
+            }
+            if (header->weightSize != sizeof(T) || header->weightKind != GraphWeightKind<T>()) {
+                throw std::runtime_error("Weight type mismatch in " + path);
+            }
+            if (header->fileSize > fileSize) {
+                throw std::runtime_error("Truncated graph file: " + path);
+            }
+            directed = (header->flags & GraphFileDirected) != 0;
+            vertexCount = static_cast<size_t>(header->vertexCount);
+            edgeCount = static_cast<size_t>(header->edgeCount);
+            if (vertexCount == std::numeric_limits<size_t>::max()) {
+                throw std::runtime_error("Truncated graph file: " + path);
+            }
+            ids = section<uint64_t>(header->idsOffset, vertexCount);
+            idOrder = section<uint64_t>(header->idOrderOffset, vertexCount);
+            offsets = section<uint64_t>(header->offsetsOffset, vertexCount + 1);
+            targets = section<uint64_t>(header->targetsOffset, edgeCount);
+            weights = section<T>(header->weightsOffset, edgeCount);
+            if (!consistent()) {
+                throw std::runtime_error("Corrupted graph file: " + path);
+            }
+        } catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    MappedGraph(const MappedGraph<T>&) = delete;
+    MappedGraph<T>& operator=(const MappedGraph<T>&) = delete;
+
+    ~MappedGraph() override {
+        close();
+    }
+
+    bool IsDirected() const { return directed; }
+    size_t GetVertexCount() const { return vertexCount; }
+    size_t GetEdgeCount() const { return edgeCount; }
+    const std::string& GetPath() const { return path; }
+
+    // Плотный индекс вершины или GetVertexCount(), если её нет (двоичный поиск по idOrder)
+    size_t FindVertexIndex(size_t vertex) const {
+        size_t low = 0;
+        size_t high = vertexCount;
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            if (ids[idOrder[middle]] < vertex) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low < vertexCount && ids[idOrder[low]] == vertex ? static_cast<size_t>(idOrder[low]) : vertexCount;
+    }
+
+    size_t GetVertexId(size_t index) const {
+        if (index >= vertexCount) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        return static_cast<size_t>(ids[index]);
+    }
+
+    // Соседи и веса вершины с плотным индексом index — прямо из отображения, без копирования
+    ArraySpan<const uint64_t> GetNeighborIndices(size_t index) const {
+        if (index >= vertexCount) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        return ArraySpan<const uint64_t>(targets + offsets[index], offsets[index + 1] - offsets[index]);
+    }
+
+    ArraySpan<const T> GetNeighborWeights(size_t index) const {
+        if (index >= vertexCount) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        return ArraySpan<const T>(weights + offsets[index], offsets[index + 1] - offsets[index]);
+    }
+
+    void AddVertex(size_t) override {
+        throw std::logic_error("MappedGraph is read-only");
+    }
+
+    void AddEdge(size_t, size_t, T) override {
+        throw std::logic_error("MappedGraph is read-only");
+    }
+
+    ShrdPtr<ArraySequence<size_t>> GetVertices() const override {
+        auto result = MakeShrd<ArraySequence<size_t>>();
+        result->Reserve(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            result->Add(static_cast<size_t>(ids[i]));
+        }
+        return result;
+    }
+
+    ShrdPtr<ArraySequence<std::pair<size_t, T>>> GetEdges(size_t vertex) const override {
+        size_t index = requireIndex(vertex);
+        auto result = MakeShrd<ArraySequence<std::pair<size_t, T>>>();
+        result->Reserve(offsets[index + 1] - offsets[index]);
+        for (uint64_t edge = offsets[index]; edge < offsets[index + 1]; ++edge) {
+            result->Add(std::make_pair(static_cast<size_t>(ids[targets[edge]]), weights[edge]));
+        }
+        return result;
+    }
+
+    // В очереди лежат пары (вершина, расстояние на момент вставки): устаревшие записи пропускаются
+    ShrdPtr<ArraySequence<T>> ShortestPaths(size_t start) const override {
+        size_t source = requireIndex(start);
+        DynamicArray<T> distances(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            distances.UncheckedGet(i) = std::numeric_limits<T>::max();
+        }
+        PriorityQueue<std::pair<size_t, T>, T> queue;
+        distances.UncheckedGet(source) = 0;
+        queue.Enqueue(std::make_pair(source, T(0)), 0);
+
+        while (queue.GetLength() > 0) {
+            std::pair<size_t, T> current = queue.Dequeue();
+            if (distances.UncheckedGet(current.first) < current.second) {
+                continue;
+            }
+            for (uint64_t edge = offsets[current.first]; edge < offsets[current.first + 1]; ++edge) {
+                size_t neighbor = static_cast<size_t>(targets[edge]);
+                T newDistance = current.second + weights[edge];
+                if (newDistance < distances.UncheckedGet(neighbor)) {
+                    distances.UncheckedGet(neighbor) = newDistance;
+                    queue.Enqueue(std::make_pair(neighbor, newDistance), newDistance);
+                }
+            }
+        }
+        return MakeShrd<ArraySequence<T>>(distances.Data(), vertexCount);
+    }
+
+    T FindBestPath(size_t start, size_t end) const override {
+        size_t target = FindVertexIndex(end);
+        if (target == vertexCount) {
+            throw std::out_of_range("End vertex not found in the graph");
+        }
+        T distance = ShortestPaths(start)->UncheckedGet(target);
+        if (directed && distance == std::numeric_limits<T>::max()) {
+            throw std::runtime_error("There is no path from start to end vertex.");
+        }
+        return distance;
+    }
+
+    // Алгоритм Прима от первой вершины, как в UndirectedGraph
+    ShrdPtr<ArraySequence<std::pair<size_t, size_t>>> FindMST() const override {
+        if (directed) {
+            throw std::logic_error("FindMST is not supported for directed graphs.");
+        }
+        auto mst = MakeShrd<ArraySequence<std::pair<size_t, size_t>>>();
+        if (vertexCount == 0) {
+            return mst;
+        }
+        DynamicArray<unsigned char> inMST = unvisited();
+        PriorityQueue<std::pair<size_t, size_t>, T> edges;
+        auto addEdges = [this, &inMST, &edges](size_t from) {
+            for (uint64_t edge = offsets[from]; edge < offsets[from + 1]; ++edge) {
+                if (!inMST.UncheckedGet(targets[edge])) {
+                    edges.Enqueue(std::make_pair(from, static_cast<size_t>(targets[edge])), weights[edge]);
+                }
+            }
+        };
+        inMST.UncheckedGet(0) = 1;
+        addEdges(0);
+        while (mst->GetLength() < vertexCount - 1 && edges.GetLength() > 0) {
+            std::pair<size_t, size_t> edge = edges.Dequeue();
+            if (inMST.UncheckedGet(edge.second)) {
+                continue;
+            }
+            mst->Add(std::make_pair(static_cast<size_t>(ids[edge.first]), static_cast<size_t>(ids[edge.second])));
+            inMST.UncheckedGet(edge.second) = 1;
+            addEdges(edge.second);
+        }
+        return mst;
+    }
+
+    ShrdPtr<ArraySequence<ShrdPtr<ArraySequence<size_t>>>> FindConnectedComponents() const override {
+        if (directed) {
+            return FindStronglyConnectedComponents();
+        }
+        DynamicArray<unsigned char> visited = unvisited();
+        auto components = MakeShrd<ArraySequence<ShrdPtr<ArraySequence<size_t>>>>();
+        for (size_t i = 0; i < vertexCount; ++i) {
+            if (!visited.UncheckedGet(i)) {
+                auto component = MakeShrd<ArraySequence<size_t>>();
+                depthFirst(i, offsets, targets, visited,
+                           [this, &component](size_t v) { component->Add(static_cast<size_t>(ids[v])); }, [](size_t) {});
+                components->Add(component);
+            }
+        }
+        return components;
+    }
+
+    // Косарайю: порядок выхода на прямом графе, затем обход транспонированного CSR, построенного в памяти
+    ShrdPtr<ArraySequence<ShrdPtr<ArraySequence<size_t>>>> FindStronglyConnectedComponents() const override {
+        if (!directed) {
+            throw std::logic_error("This operation is not supported for undirected graphs");
+        }
+        auto order = postOrder();
+
+        DynamicArray<uint64_t> reverseOffsets(vertexCount + 1);
+        std::memset(reverseOffsets.Data(), 0, (vertexCount + 1) * sizeof(uint64_t));
+        for (size_t edge = 0; edge < edgeCount; ++edge) {
+            ++reverseOffsets.UncheckedGet(targets[edge] + 1);
+        }
+        for (size_t i = 0; i < vertexCount; ++i) {
+            reverseOffsets.UncheckedGet(i + 1) += reverseOffsets.UncheckedGet(i);
+        }
+        DynamicArray<uint64_t> reverseTargets(edgeCount);
+        DynamicArray<uint64_t> cursor(reverseOffsets.Data(), vertexCount);
+        for (size_t from = 0; from < vertexCount; ++from) {
+            for (uint64_t edge = offsets[from]; edge < offsets[from + 1]; ++edge) {
+                reverseTargets.UncheckedGet(cursor.UncheckedGet(targets[edge])++) = from;
+            }
+        }
+
+        DynamicArray<unsigned char> visited = unvisited();
+        auto components = MakeShrd<ArraySequence<ShrdPtr<ArraySequence<size_t>>>>();
+        for (size_t i = order->GetLength(); i > 0; --i) {
+            size_t vertex = order->UncheckedGet(i - 1);
+            if (!visited.UncheckedGet(vertex)) {
+                auto component = MakeShrd<ArraySequence<size_t>>();
+                depthFirst(vertex, reverseOffsets.Data(), reverseTargets.Data(), visited,
+                           [this, &component](size_t v) { component->Add(static_cast<size_t>(ids[v])); }, [](size_t) {});
+                components->Add(component);
+            }
+        }
+        return components;
+    }
+
+    // Тот же порядок, что у DirectedGraph: вершины в порядке выхода из DFS
+    ShrdPtr<ArraySequence<size_t>> TopologicalSort() const override {
+        if (!directed) {
+            throw std::logic_error("This operation is not supported for undirected graphs");
+        }
+        auto order = postOrder();
+        for (size_t i = 0; i < order->GetLength(); ++i) {
+            order->UncheckedGet(i) = static_cast<size_t>(ids[order->UncheckedGet(i)]);
+        }
+        return order;
+    }
+
+    // Отображение не занимает кучу, но считается: это страницы, которые граф может держать в памяти
+    size_t MemoryUsage() const override {
+        return sizeof(*this) + mappedBytes;
+    }
+};
+
+#endif //MAPPEDGRAPH_H
@@ -1,7 +1,7 @@
 #ifndef PRIORITYQUEUE_H
 #define PRIORITYQUEUE_H
 
-#include "ArraySequence.h"
+#include "DequeSequence.h"
 #include <stdexcept>
 #include <algorithm>
 
@@ -16,14 +16,14 @@ private:
         Node(const T& newItem, const K& newPriority) : item(newItem), priority(newPriority) {}
     };
 
-    ArraySequence<Node> sequence;
+    DequeSequence<Node> sequence;
     Compare comp;
 
     void HeapifyUp(int index) {
         while (index > 0) {
             int parentIndex = (index - 1) / 2;
-            if (!comp(sequence.Get(index).priority, sequence.Get(parentIndex).priority)) break;
-            std::swap(sequence.Get(index), sequence.Get(parentIndex));
+            if (!comp(sequence.UncheckedGet(index).priority, sequence.UncheckedGet(parentIndex).priority)) break;
+            std::swap(sequence.UncheckedGet(index), sequence.UncheckedGet(parentIndex));
             index = parentIndex;
         }
     }
@@ -35,14 +35,14 @@ private:
             int rightChild = 2 * index + 2;
             int smallest = index;
 
-            if (leftChild < size && comp(sequence.Get(leftChild).priority, sequence.Get(smallest).priority)) {
+            if (leftChild < size && comp(sequence.UncheckedGet(leftChild).priority, sequence.UncheckedGet(smallest).priority)) {
                 smallest = leftChild;
             }
-            if (rightChild < size && comp(sequence.Get(rightChild).priority, sequence.Get(smallest).priority)) {
+            if (rightChild < size && comp(sequence.UncheckedGet(rightChild).priority, sequence.UncheckedGet(smallest).priority)) {
                 smallest = rightChild;
             }
             if (smallest == index) break;
-            std::swap(sequence.Get(index), sequence.Get(smallest));
+            std::swap(sequence.UncheckedGet(index), sequence.UncheckedGet(smallest));
             index = smallest;
         }
     }
@@ -55,7 +55,7 @@ public:
     PriorityQueue() {}
 
     void Enqueue(const T& item, const K& priority) {
-        sequence = sequence.Append(Node(item, priority));
+        sequence.PushBack(Node(item, priority));
         HeapifyUp(sequence.GetLength() - 1);
     }
 
@@ -63,9 +63,9 @@ public:
         if (sequence.GetLength() == 0) {
             throw std::out_of_range("PriorityQueue is empty");
         }
-        T first = sequence.Get(0).item;
-        std::swap(sequence.Get(0), sequence.Get(sequence.GetLength() - 1));
-        sequence.RemoveAt(sequence.GetLength() - 1);
+        T first = sequence.UncheckedGet(0).item;
+        std::swap(sequence.UncheckedGet(0), sequence.UncheckedGet(sequence.GetLength() - 1));
+        sequence.PopBack();
         HeapifyDown(0);
         return first;
     }
@@ -74,7 +74,7 @@ public:
         if (sequence.GetLength() == 0) {
             throw std::out_of_range("PriorityQueue is empty");
         }
-        return sequence.Get(0).item;
+        return sequence.UncheckedGet(0).item;
     }
 
     bool IsEmpty() const {
@@ -5,6 +5,9 @@
 #include "HashTableDictionary.h"
 #include "PriorityQueue.h"
 #include "ArraySequence.h"
+#include "Arena.h"
+#include "GraphFile.h"
+#include "GraphBatch.h"
 
 template <typename T>
 class UndirectedGraph : public IGraph<T> {
@@ -16,7 +19,7 @@ private:
         component->Add(vertex);
         auto edges = GetEdges(vertex);
         for (size_t i = 0; i < edges->GetLength(); ++i) {
-            size_t neighbor = edges->Get(i).first;
+            size_t neighbor = edges->UncheckedGet(i).first;
             if (!visited.Get(neighbor)) {
                 DFS(neighbor, visited, component);
             }
@@ -30,6 +33,52 @@ public:
         }
     }
 
+    // Для массовой загрузки: таблица смежности сразу рассчитана на expectedDegree рёбер
+    void AddVertex(size_t vertex, size_t expectedDegree) {
+        if (!adjList.ContainsKey(vertex)) {
+            HashTableDictionary<size_t, T> edges;
+            edges.Reserve(expectedDegree);
+            adjList.Add(vertex, edges);
+        } else {
+            adjList.Get(vertex).Reserve(expectedDegree);
+        }
+    }
+
+    void ReserveVertices(size_t vertexCount) {
+        adjList.Reserve(vertexCount);
+    }
+
+    size_t GetVertexCount() const {
+        return adjList.GetCount();
+    }
+
+    void AddVertices(const ArraySequence<size_t>& batch) {
+        adjList.Reserve(adjList.GetCount() + batch.GetLength());
+        for (size_t vertex : batch) {
+            AddVertex(vertex);
+        }
+    }
+
+    // Результат тот же, что у AddEdge для каждого ребра по порядку, но таблицы выделяются один раз (см. GraphBatch.h)
+    void AddEdges(const GraphEdge<T>* batch, size_t count, ExecutionPolicy policy = ExecutionPolicy::Sequential,
+                  ThreadPool& pool = ThreadPool::Instance()) {
+        // Каждое ребро хранится в обеих таблицах смежности: в пакет идут дуги в обе стороны
+        DynamicArray<GraphEdge<T>> arcs;
+        arcs.Reserve(count * 2);
+        for (size_t i = 0; i < count; ++i) {
+            arcs.PushBack(batch[i]);
+            if (batch[i].from != batch[i].to) {
+                arcs.PushBack(GraphEdge<T>{batch[i].to, batch[i].from, batch[i].weight});
+            }
+        }
+        InsertArcs(adjList, arcs, false, policy, pool);
+    }
+
+    void AddEdges(const ArraySequence<GraphEdge<T>>& batch, ExecutionPolicy policy = ExecutionPolicy::Sequential,
+                  ThreadPool& pool = ThreadPool::Instance()) {
+        AddEdges(batch.Data(), batch.GetLength(), policy, pool);
+    }
+
     void AddEdge(size_t from, size_t to, T weight) override {
         AddVertex(from);
         AddVertex(to);
@@ -39,7 +88,7 @@ public:
 
     ShrdPtr<ArraySequence<size_t>> GetVertices() const override {
         auto vertices = adjList.GetAllItems();
-        auto result = ShrdPtr<ArraySequence<size_t>>(new ArraySequence<size_t>());
+        auto result = MakeShrd<ArraySequence<size_t>>();
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
             result->Add(vertices->Get(i).first);
         }
@@ -51,7 +100,7 @@ public:
             throw std::out_of_range("Vertex not found");
         }
         auto edges = adjList.Get(vertex).GetAllItems();
-        auto result = ShrdPtr<ArraySequence<std::pair<size_t, T>>>(new ArraySequence<std::pair<size_t, T>>());
+        auto result = MakeShrd<ArraySequence<std::pair<size_t, T>>>();
         for (size_t i = 0; i < edges->GetLength(); ++i) {
             result->Add(edges->Get(i));
         }
@@ -59,12 +108,14 @@ public:
     }
 
     ShrdPtr<ArraySequence<T>> ShortestPaths(size_t start) const override {
-        HashTableDictionary<size_t, T> distances;
+        auto vertices = GetVertices();
+        // Таблица расстояний живёт только во время запроса: вся её память берётся из арены
+        Arena scratch;
+        HashTableDictionary<size_t, T> distances(vertices->GetLength() * 2 + 1, &scratch);
         PriorityQueue<size_t, T> queue;
 
-        auto vertices = GetVertices();
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            distances.Add(vertices->Get(i), std::numeric_limits<T>::max());
+            distances.Add(vertices->UncheckedGet(i), std::numeric_limits<T>::max());
         }
 
         distances.Get(start) = 0;
@@ -75,8 +126,8 @@ public:
             auto edges = GetEdges(current);
 
             for (size_t i = 0; i < edges->GetLength(); ++i) {
-                size_t neighbor = edges->Get(i).first;
-                T weight = edges->Get(i).second;
+                size_t neighbor = edges->UncheckedGet(i).first;
+                T weight = edges->UncheckedGet(i).second;
 
                 T newDistance = distances.Get(current) + weight;
                 if (newDistance < distances.Get(neighbor)) {
@@ -86,9 +137,9 @@ public:
             }
         }
 
-        auto result = ShrdPtr<ArraySequence<T>>(new ArraySequence<T>());
+        auto result = MakeShrd<ArraySequence<T>>();
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            result->Add(distances.Get(vertices->Get(i)));
+            result->Add(distances.Get(vertices->UncheckedGet(i)));
         }
 
         return result;
@@ -99,8 +150,8 @@ public:
         auto vertices = GetVertices();
 
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            if (vertices->Get(i) == end) {
-                return distances->Get(i);
+            if (vertices->UncheckedGet(i) == end) {
+                return distances->UncheckedGet(i);
             }
         }
         throw std::out_of_range("End vertex not found in the graph");
@@ -110,18 +161,18 @@ public:
         auto vertices = GetVertices();
         HashTableDictionary<size_t, bool> inMST;
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            inMST.Add(vertices->Get(i), false);
+            inMST.Add(vertices->UncheckedGet(i), false);
         }
 
         PriorityQueue<std::pair<size_t, size_t>, T> edges;
-        auto mst = ShrdPtr<ArraySequence<std::pair<size_t, size_t>>>(new ArraySequence<std::pair<size_t, size_t>>());
+        auto mst = MakeShrd<ArraySequence<std::pair<size_t, size_t>>>();
 
         size_t start = vertices->Get(0);
         inMST.Get(start) = true;
 
         auto initialEdges = GetEdges(start);
         for (size_t i = 0; i < initialEdges->GetLength(); ++i) {
-            edges.Enqueue({start, initialEdges->Get(i).first}, initialEdges->Get(i).second);
+            edges.Enqueue({start, initialEdges->UncheckedGet(i).first}, initialEdges->UncheckedGet(i).second);
         }
 
         while (mst->GetLength() < vertices->GetLength() - 1 && edges.GetLength() > 0) {
@@ -135,8 +186,8 @@ public:
 
             auto newEdges = GetEdges(to);
             for (size_t i = 0; i < newEdges->GetLength(); ++i) {
-                size_t neighbor = newEdges->Get(i).first;
-                T weight = newEdges->Get(i).second;
+                size_t neighbor = newEdges->UncheckedGet(i).first;
+                T weight = newEdges->UncheckedGet(i).second;
                 if (!inMST.Get(neighbor)) {
                     edges.Enqueue({to, neighbor}, weight);
                 }
@@ -150,14 +201,14 @@ public:
         auto vertices = GetVertices();
         HashTableDictionary<size_t, bool> visited;
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            visited.Add(vertices->Get(i), false);
+            visited.Add(vertices->UncheckedGet(i), false);
         }
 
-        auto components = ShrdPtr<ArraySequence<ShrdPtr<ArraySequence<size_t>>>>(new ArraySequence<ShrdPtr<ArraySequence<size_t>>>());
+        auto components = MakeShrd<ArraySequence<ShrdPtr<ArraySequence<size_t>>>>();
         for (size_t i = 0; i < vertices->GetLength(); ++i) {
-            size_t vertex = vertices->Get(i);
+            size_t vertex = vertices->UncheckedGet(i);
             if (!visited.Get(vertex)) {
-                auto component = ShrdPtr<ArraySequence<size_t>>(new ArraySequence<size_t>());
+                auto component = MakeShrd<ArraySequence<size_t>>();
                 DFS(vertex, visited, component);
                 components->Add(component);
             }
@@ -173,6 +224,14 @@ public:
     ShrdPtr<ArraySequence<size_t>> TopologicalSort() const override {
         throw std::logic_error("This operation is not supported for undirected graphs");
     }
+    // Двоичный CSR-файл, который открывается через MappedGraph без разбора
+    void Save(const std::string& path) const {
+        SaveGraph(*this, path, false);
+    }
+
+    size_t MemoryUsage() const override {
+        return sizeof(*this) - sizeof(adjList) + adjList.MemoryUsage();
+    }
 };
 
 #endif // UNDIRECTEDGRAPH_H
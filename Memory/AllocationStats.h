@@ -0,0 +1,99 @@
+#ifndef ALLOCATIONSTATS_H
+#define ALLOCATIONSTATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Учёт выделений памяти по видам контейнеров. Счётчики работают, только если
+// определён LAB4_ALLOCATION_STATS; без него Record* пустые и компилятор их убирает
+enum class AllocationCategory {
+    DynamicArray,
+    HashTable,
+    ControlBlock,
+    ListNode,
+    Count
+};
+
+struct AllocationCounters {
+    size_t allocations;
+    size_t deallocations;
+    size_t liveBytes;
+    size_t peakBytes;
+};
+
+class AllocationStats {
+private:
+    struct Slot {
+        std::atomic<size_t> allocations{0};
+        std::atomic<size_t> deallocations{0};
+        std::atomic<size_t> liveBytes{0};
+        std::atomic<size_t> peakBytes{0};
+    };
+
+    static Slot& slot(AllocationCategory category) {
+        static Slot slots[static_cast<size_t>(AllocationCategory::Count)];
+        return slots[static_cast<size_t>(category)];
+    }
+
+public:
+#ifdef LAB4_ALLOCATION_STATS
+    static constexpr bool Enabled = true;
+#else
+    static constexpr bool Enabled = false;
+#endif
+
+    static void RecordAllocation(AllocationCategory category, size_t bytes) {
+        if constexpr (Enabled) {
+            Slot& counters = slot(category);
+            counters.allocations.fetch_add(1, std::memory_order_relaxed);
+            size_t live = counters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            size_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+            while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    static void RecordDeallocation(AllocationCategory category, size_t bytes) {
+        if constexpr (Enabled) {
+            Slot& counters = slot(category);
+            counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+            counters.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    static AllocationCounters Get(AllocationCategory category) {
+        Slot& counters = slot(category);
+        return {counters.allocations.load(std::memory_order_relaxed),
+                counters.deallocations.load(std::memory_order_relaxed),
+                counters.liveBytes.load(std::memory_order_relaxed),
+                counters.peakBytes.load(std::memory_order_relaxed)};
+    }
+
+    // Пиковое значение начинается заново с текущего объёма живой памяти
+    static void ResetPeaks() {
+        for (size_t i = 0; i < static_cast<size_t>(AllocationCategory::Count); ++i) {
+            Slot& counters = slot(static_cast<AllocationCategory>(i));
+            counters.peakBytes.store(counters.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+};
+
+template <typename T, typename = void>
+struct HasMemoryUsage : std::false_type {};
+
+template <typename T>
+struct HasMemoryUsage<T, std::void_t<decltype(std::declval<const T&>().MemoryUsage())>> : std::true_type {};
+
+// Память, которой value владеет вне себя (для вложенных контейнеров); 0 для остальных типов
+template <typename T>
+size_t OwnedMemoryUsage(const T& value) {
+    if constexpr (HasMemoryUsage<T>::value) {
+        return value.MemoryUsage() - sizeof(T);
+    } else {
+        return 0;
+    }
+}
+
+#endif //ALLOCATIONSTATS_H
@@ -0,0 +1,84 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "MemoryResource.h"
+#include <cstdint>
+
+// Линейный (bump-pointer) аллокатор: Deallocate ничего не делает,
+// вся память возвращается разом в Release() или в деструкторе
+class Arena : public MemoryResource {
+private:
+    struct Block {
+        Block* previous;
+        size_t size;
+    };
+
+    Block* head;
+    char* cursor;
+    char* limit;
+    size_t nextBlockSize;
+    size_t allocatedBytes;
+    MemoryResource* upstream;
+
+    static char* alignUp(char* pointer, size_t alignment) {
+        uintptr_t value = reinterpret_cast<uintptr_t>(pointer);
+        return reinterpret_cast<char*>((value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+    }
+
+    void addBlock(size_t minimumBytes) {
+        size_t size = nextBlockSize;
+        while (size < minimumBytes + sizeof(Block)) {
+            size *= 2;
+        }
+        auto block = static_cast<Block*>(AllocateFrom(upstream, size, alignof(std::max_align_t)));
+        block->previous = head;
+        block->size = size;
+        head = block;
+        cursor = reinterpret_cast<char*>(block) + sizeof(Block);
+        limit = reinterpret_cast<char*>(block) + size;
+        nextBlockSize = size * 2;
+    }
+
+public:
+    explicit Arena(size_t initialBlockSize = 64 * 1024, MemoryResource* upstream = nullptr)
+        : head(nullptr), cursor(nullptr), limit(nullptr),
+          nextBlockSize(initialBlockSize > 2 * sizeof(Block) ? initialBlockSize : 2 * sizeof(Block)),
+          allocatedBytes(0), upstream(upstream) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() override {
+        Release();
+    }
+
+    void* Allocate(size_t bytes, size_t alignment) override {
+        char* result = cursor ? alignUp(cursor, alignment) : nullptr;
+        if (!result || result + bytes > limit) {
+            addBlock(bytes + alignment);
+            result = alignUp(cursor, alignment);
+        }
+        cursor = result + bytes;
+        allocatedBytes += bytes;
+        return result;
+    }
+
+    void Deallocate(void*, size_t, size_t) override {}
+
+    void Release() {
+        while (head) {
+            Block* previous = head->previous;
+            DeallocateFrom(upstream, head, head->size, alignof(std::max_align_t));
+            head = previous;
+        }
+        cursor = nullptr;
+        limit = nullptr;
+        allocatedBytes = 0;
+    }
+
+    size_t GetAllocatedBytes() const {
+        return allocatedBytes;
+    }
+};
+
+#endif //ARENA_H
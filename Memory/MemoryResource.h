@@ -0,0 +1,39 @@
+#ifndef MEMORYRESOURCE_H
+#define MEMORYRESOURCE_H
+
+#include <cstddef>
+#include <new>
+
+// Источник памяти для контейнеров (аналог std::pmr::memory_resource).
+// Контейнеры принимают MemoryResource*; nullptr означает глобальные new/delete
+class MemoryResource {
+public:
+    virtual void* Allocate(size_t bytes, size_t alignment) = 0;
+    virtual void Deallocate(void* memory, size_t bytes, size_t alignment) = 0;
+    virtual ~MemoryResource() = default;
+};
+
+inline void* AllocateFrom(MemoryResource* resource, size_t bytes, size_t alignment) {
+    if (resource) {
+        return resource->Allocate(bytes, alignment);
+    }
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+    return ::operator new(bytes);
+}
+
+inline void DeallocateFrom(MemoryResource* resource, void* memory, size_t bytes, size_t alignment) {
+    if (!memory) {
+        return;
+    }
+    if (resource) {
+        resource->Deallocate(memory, bytes, alignment);
+    } else if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(memory, std::align_val_t(alignment));
+    } else {
+        ::operator delete(memory);
+    }
+}
+
+#endif //MEMORYRESOURCE_H
@@ -0,0 +1,106 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include "MemoryResource.h"
+
+// Пул блоков одного размера со списком свободных блоков. Запросы крупнее блока
+// или с большим выравниванием передаются в upstream
+class Pool : public MemoryResource {
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct Chunk {
+        Chunk* next;
+    };
+
+    size_t blockSize;
+    size_t blockAlignment;
+    size_t blocksPerChunk;
+    size_t chunkHeader;
+    FreeNode* freeList;
+    Chunk* chunks;
+    MemoryResource* upstream;
+
+    static size_t roundUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    size_t chunkBytes() const {
+        return chunkHeader + blockSize * blocksPerChunk;
+    }
+
+    void refill() {
+        auto chunk = static_cast<Chunk*>(AllocateFrom(upstream, chunkBytes(), blockAlignment));
+        chunk->next = chunks;
+        chunks = chunk;
+        char* first = reinterpret_cast<char*>(chunk) + chunkHeader;
+        for (size_t i = blocksPerChunk; i > 0; --i) {
+            auto node = reinterpret_cast<FreeNode*>(first + (i - 1) * blockSize);
+            node->next = freeList;
+            freeList = node;
+        }
+    }
+
+    bool fits(size_t bytes, size_t alignment) const {
+        return bytes <= blockSize && alignment <= blockAlignment;
+    }
+
+public:
+    Pool(size_t blockSize, size_t blockAlignment = alignof(std::max_align_t), size_t blocksPerChunk = 256,
+         MemoryResource* upstream = nullptr)
+        : blockAlignment(blockAlignment < alignof(FreeNode) ? alignof(FreeNode) : blockAlignment),
+          blocksPerChunk(blocksPerChunk > 0 ? blocksPerChunk : 1), freeList(nullptr), chunks(nullptr), upstream(upstream) {
+        this->blockSize = roundUp(blockSize < sizeof(FreeNode) ? sizeof(FreeNode) : blockSize, this->blockAlignment);
+        chunkHeader = roundUp(sizeof(Chunk), this->blockAlignment);
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    ~Pool() override {
+        Release();
+    }
+
+    void* Allocate(size_t bytes, size_t alignment) override {
+        if (!fits(bytes, alignment)) {
+            return AllocateFrom(upstream, bytes, alignment);
+        }
+        if (!freeList) {
+            refill();
+        }
+        FreeNode* node = freeList;
+        freeList = node->next;
+        return node;
+    }
+
+    void Deallocate(void* memory, size_t bytes, size_t alignment) override {
+        if (!memory) {
+            return;
+        }
+        if (!fits(bytes, alignment)) {
+            DeallocateFrom(upstream, memory, bytes, alignment);
+            return;
+        }
+        auto node = static_cast<FreeNode*>(memory);
+        node->next = freeList;
+        freeList = node;
+    }
+
+    // Возвращает все блоки разом; выданные указатели становятся недействительными
+    void Release() {
+        while (chunks) {
+            Chunk* next = chunks->next;
+            DeallocateFrom(upstream, chunks, chunkBytes(), blockAlignment);
+            chunks = next;
+        }
+        freeList = nullptr;
+    }
+
+    size_t GetBlockSize() const {
+        return blockSize;
+    }
+};
+
+#endif //POOL_H
@@ -0,0 +1,127 @@
+#ifndef INTRUSIVEPTR_H
+#define INTRUSIVEPTR_H
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Счётчик ссылок внутри самого объекта. При копировании объекта счётчик не копируется.
+// Счётчик не атомарный: объект с IntrusivePtr нельзя разделять между потоками
+class RefCountedBase {
+private:
+    mutable size_t refCount;
+
+    template <typename T>
+    friend class IntrusivePtr;
+
+protected:
+    RefCountedBase() : refCount(0) {}
+    RefCountedBase(const RefCountedBase&) : refCount(0) {}
+    RefCountedBase& operator=(const RefCountedBase&) { return *this; }
+    ~RefCountedBase() = default;
+
+public:
+    size_t GetRefCount() const { return refCount; }
+};
+
+// Освобождение объекта, когда счётчик обнулился. Типы, память которых выделена
+// не через new, объявляют перегрузку DestroyIntrusive рядом с собой (находится через ADL)
+template <typename T>
+void DestroyIntrusive(T* object) {
+    delete object;
+}
+
+// Указатель на объект-наследник RefCountedBase: один указатель без отдельного блока управления.
+// Разыменование не проверяет nullptr — это внутренний указатель для горячих циклов
+template <typename T>
+class IntrusivePtr {
+private:
+    T* ptr;
+
+    void acquire() const {
+        if (ptr) {
+            ++ptr->refCount;
+        }
+    }
+
+    void release() {
+        if (ptr && --ptr->refCount == 0) {
+            DestroyIntrusive(ptr);
+        }
+    }
+
+    template <typename U>
+    friend class IntrusivePtr;
+
+public:
+    IntrusivePtr() : ptr(nullptr) {}
+
+    explicit IntrusivePtr(T* p) : ptr(p) {
+        static_assert(std::is_base_of<RefCountedBase, T>::value, "IntrusivePtr requires T derived from RefCountedBase");
+        acquire();
+    }
+
+    IntrusivePtr(const IntrusivePtr& other) : ptr(other.ptr) {
+        acquire();
+    }
+
+    IntrusivePtr(IntrusivePtr&& other) noexcept : ptr(other.ptr) {
+        other.ptr = nullptr;
+    }
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    IntrusivePtr(const IntrusivePtr<U>& other) : ptr(other.ptr) {
+        acquire();
+    }
+
+    ~IntrusivePtr() {
+        release();
+    }
+
+    IntrusivePtr& operator=(const IntrusivePtr& other) {
+        other.acquire();
+        release();
+        ptr = other.ptr;
+        return *this;
+    }
+
+    IntrusivePtr& operator=(IntrusivePtr&& other) noexcept {
+        if (this != &other) {
+            release();
+            ptr = other.ptr;
+            other.ptr = nullptr;
+        }
+        return *this;
+    }
+
+    T& operator*() const { return *ptr; }
+    T* operator->() const { return ptr; }
+    T* Get() const { return ptr; }
+
+    bool operator!() const {
+        return ptr == nullptr;
+    }
+    bool operator!=(std::nullptr_t) const {
+        return ptr != nullptr;
+    }
+
+    operator bool() const {
+        return ptr != nullptr;
+    }
+
+    void reset() {
+        release();
+        ptr = nullptr;
+    }
+
+    size_t getRefCount() const {
+        return ptr ? ptr->refCount : 0;
+    }
+};
+
+template <typename T, typename... Args>
+IntrusivePtr<T> MakeIntrusive(Args&&... args) {
+    return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+#endif //INTRUSIVEPTR_H
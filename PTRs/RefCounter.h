@@ -0,0 +1,162 @@
+#ifndef REFCOUNTER_H
+#define REFCOUNTER_H
+
+#include "MemoryResource.h"
+#include "AllocationStats.h"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Политики подсчёта ссылок. SingleThreadPolicy — обычные счётчики без накладных расходов,
+// AtomicPolicy — атомарные, для указателей, которые передаются между потоками
+struct SingleThreadPolicy {
+    using Counter = size_t;
+
+    static void Increment(Counter& counter) { ++counter; }
+    static size_t Decrement(Counter& counter) { return --counter; }
+    static size_t Load(const Counter& counter) { return counter; }
+
+    static bool IncrementIfNonZero(Counter& counter) {
+        if (counter == 0) {
+            return false;
+        }
+        ++counter;
+        return true;
+    }
+};
+
+struct AtomicPolicy {
+    using Counter = std::atomic<size_t>;
+
+    static void Increment(Counter& counter) { counter.fetch_add(1, std::memory_order_relaxed); }
+    static size_t Decrement(Counter& counter) { return counter.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+    static size_t Load(const Counter& counter) { return counter.load(std::memory_order_acquire); }
+
+    static bool IncrementIfNonZero(Counter& counter) {
+        size_t current = counter.load(std::memory_order_relaxed);
+        while (current != 0) {
+            if (counter.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template <typename T, typename Policy = SingleThreadPolicy>
+class ShrdPtr;
+
+template <typename T, typename Policy = SingleThreadPolicy>
+class WeekPtr;
+
+// Блок управления для ShrdPtr/WeekPtr. Пока жив хотя бы один ShrdPtr, сильные ссылки
+// вместе держат одну слабую, поэтому блок освобождается, когда оба счётчика обнулятся
+template <typename Policy>
+struct BasicRefCounter {
+    typename Policy::Counter strongCount;
+    typename Policy::Counter weakCount;
+
+    BasicRefCounter() : strongCount(1), weakCount(1) {}
+    BasicRefCounter(const BasicRefCounter&) = delete;
+    BasicRefCounter& operator=(const BasicRefCounter&) = delete;
+    virtual ~BasicRefCounter() = default;
+
+    virtual void DestroyObject() = 0;
+
+    // Освобождает сам блок управления; переопределяется, если блок выделен не через new
+    virtual void DestroySelf() {
+        delete this;
+    }
+
+    void AddStrong() {
+        Policy::Increment(strongCount);
+    }
+
+    bool TryAddStrong() {
+        return Policy::IncrementIfNonZero(strongCount);
+    }
+
+    void ReleaseStrong() {
+        if (Policy::Decrement(strongCount) == 0) {
+            DestroyObject();
+            ReleaseWeak();
+        }
+    }
+
+    void AddWeak() {
+        Policy::Increment(weakCount);
+    }
+
+    void ReleaseWeak() {
+        if (Policy::Decrement(weakCount) == 0) {
+            DestroySelf();
+        }
+    }
+
+    size_t GetStrongCount() const {
+        return Policy::Load(strongCount);
+    }
+};
+
+using RefCounter = BasicRefCounter<SingleThreadPolicy>;
+
+template <typename T, typename Policy = SingleThreadPolicy>
+struct PointerRefCounter : BasicRefCounter<Policy> {
+    T* object;
+
+    explicit PointerRefCounter(T* object) : object(object) {
+        AllocationStats::RecordAllocation(AllocationCategory::ControlBlock, sizeof(PointerRefCounter));
+    }
+
+    ~PointerRefCounter() override {
+        AllocationStats::RecordDeallocation(AllocationCategory::ControlBlock, sizeof(PointerRefCounter));
+    }
+
+    void DestroyObject() override {
+        delete object;
+    }
+};
+
+// Счётчик и объект в одном выделении памяти (создаётся через MakeShrd)
+template <typename T, typename Policy = SingleThreadPolicy>
+struct InplaceRefCounter : BasicRefCounter<Policy> {
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    InplaceRefCounter() {
+        AllocationStats::RecordAllocation(AllocationCategory::ControlBlock, sizeof(InplaceRefCounter));
+    }
+
+    ~InplaceRefCounter() override {
+        AllocationStats::RecordDeallocation(AllocationCategory::ControlBlock, sizeof(InplaceRefCounter));
+    }
+
+    template <typename... Args>
+    T* Construct(Args&&... args) {
+        return ::new (static_cast<void*>(storage)) T(std::forward<Args>(args)...);
+    }
+
+    T* Get() {
+        return std::launder(reinterpret_cast<T*>(storage));
+    }
+
+    void DestroyObject() override {
+        Get()->~T();
+    }
+};
+
+// Блок MakeShrd, память которого взята из MemoryResource (создаётся через AllocateShrd)
+template <typename T, typename Policy = SingleThreadPolicy>
+struct ResourceRefCounter : InplaceRefCounter<T, Policy> {
+    MemoryResource* resource;
+
+    explicit ResourceRefCounter(MemoryResource* resource) : resource(resource) {}
+
+    void DestroySelf() override {
+        MemoryResource* owner = resource;
+        this->~ResourceRefCounter();
+        DeallocateFrom(owner, this, sizeof(ResourceRefCounter), alignof(ResourceRefCounter));
+    }
+};
+
+#endif //REFCOUNTER_H
@@ -1,36 +1,77 @@
 #ifndef SHRDPTR_H
 #define SHRDPTR_H
 
+#include "RefCounter.h"
 #include "WeekPtr.h"
 
-#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-template <typename T>
+template <typename T, typename Policy, typename... Args>
+ShrdPtr<T, Policy> MakeShrdWithPolicy(Args&&... args);
+
+template <typename T, typename Policy, typename... Args>
+ShrdPtr<T, Policy> AllocateShrdWithPolicy(MemoryResource* resource, Args&&... args);
+
+template <typename T, typename Policy>
 class ShrdPtr {
 private:
-    struct RefCounter {
-        size_t count;
-        std::set<WeekPtr<T>*> weekPtrs;
-        RefCounter() : count(1) {}
-    };
+    using Counter = BasicRefCounter<Policy>;
 
     T* ptr;
-    RefCounter* refCounter;
+    Counter* refCounter;
+
+    ShrdPtr(T* p, Counter* counter) : ptr(p), refCounter(counter) {}
+
+    static Counter* createCounter(T* p) {
+        if (!p) {
+            return nullptr;
+        }
+        try {
+            return new PointerRefCounter<T, Policy>(p);
+        } catch (...) {
+            delete p;
+            throw;
+        }
+    }
+
+    void release() {
+        if (refCounter) {
+            refCounter->ReleaseStrong();
+        }
+    }
 
 public:
     ShrdPtr() : ptr(nullptr), refCounter(nullptr) {}
 
-    explicit ShrdPtr(T* p) : ptr(p), refCounter(p ? new RefCounter() : nullptr) {}
+    explicit ShrdPtr(T* p) : ptr(p), refCounter(createCounter(p)) {}
 
     ShrdPtr(const ShrdPtr& other) : ptr(other.ptr), refCounter(other.refCounter) {
         if (refCounter) {
-            ++refCounter->count;
+            refCounter->AddStrong();
         }
     }
 
-    ShrdPtr(const WeekPtr<T>& other) : ptr(other.ptr), refCounter(other.refCounter) {
+    // Указатель на производный класс приводится к указателю на базовый с тем же счётчиком
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    ShrdPtr(const ShrdPtr<U, Policy>& other) : ptr(other.ptr), refCounter(other.refCounter) {
         if (refCounter) {
-            ++refCounter->count;
+            refCounter->AddStrong();
+        }
+    }
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    ShrdPtr(ShrdPtr<U, Policy>&& other) noexcept : ptr(other.ptr), refCounter(other.refCounter) {
+        other.ptr = nullptr;
+        other.refCounter = nullptr;
+    }
+
+    // Для истёкшего WeekPtr получается пустой ShrdPtr
+    ShrdPtr(const WeekPtr<T, Policy>& other) : ptr(nullptr), refCounter(nullptr) {
+        if (other.refCounter && other.refCounter->TryAddStrong()) {
+            ptr = other.ptr;
+            refCounter = other.refCounter;
         }
     }
 
@@ -40,36 +81,24 @@ public:
     }
 
     ~ShrdPtr() {
-        if (refCounter && --refCounter->count == 0) {
-            for (auto& weekPtr : refCounter->weekPtrs) {
-                weekPtr->invalidate();
-            }
-            delete ptr;
-            delete refCounter;
-        }
+        release();
     }
 
     ShrdPtr& operator=(const ShrdPtr& other) {
         if (this != &other) {
-            if (refCounter && --refCounter->count == 0) {
-                delete ptr;
-                delete refCounter;
+            if (other.refCounter) {
+                other.refCounter->AddStrong();
             }
+            release();
             ptr = other.ptr;
             refCounter = other.refCounter;
-            if (refCounter) {
-                ++refCounter->count;
-            }
         }
         return *this;
     }
 
     ShrdPtr& operator=(ShrdPtr&& other) noexcept {
         if (this != &other) {
-            if (refCounter && --refCounter->count == 0) {
-                delete ptr;
-                delete refCounter;
-            }
+            release();
             ptr = other.ptr;
             refCounter = other.refCounter;
             other.ptr = nullptr;
@@ -115,33 +144,91 @@ public:
     }
 
     void reset() {
-        if (refCounter && --refCounter->count == 0) {
-            delete ptr;
-            delete refCounter;
-        }
+        release();
         ptr = nullptr;
         refCounter = nullptr;
     }
 
     void reset(T* newPtr) {
-        if (refCounter && --refCounter->count == 0) {
-            delete ptr;
-            delete refCounter;
-        }
+        Counter* newCounter = createCounter(newPtr);
+        release();
         ptr = newPtr;
-        refCounter = newPtr ? new RefCounter() : nullptr;
+        refCounter = newCounter;
     }
 
-    RefCounter* getRefCounter() const { return refCounter; }
+    Counter* getRefCounter() const { return refCounter; }
 
     size_t getRefCount() const {
-        return refCounter ? refCounter->count : 0;
+        return refCounter ? refCounter->GetStrongCount() : 0;
     }
 
     operator bool() const {
         return ptr != nullptr;
     }
 
-    friend class WeekPtr<T>;
+    friend class WeekPtr<T, Policy>;
+
+    template <typename U, typename P>
+    friend class ShrdPtr;
+
+    template <typename U, typename P, typename... Args>
+    friend ShrdPtr<U, P> MakeShrdWithPolicy(Args&&... args);
+
+    template <typename U, typename P, typename... Args>
+    friend ShrdPtr<U, P> AllocateShrdWithPolicy(MemoryResource* resource, Args&&... args);
 };
+
+// Указатель с атомарными счётчиками: копии можно передавать в другие потоки
+template <typename T>
+using AtomicShrdPtr = ShrdPtr<T, AtomicPolicy>;
+
+template <typename T>
+using AtomicWeekPtr = WeekPtr<T, AtomicPolicy>;
+
+// Создаёт объект за одно выделение памяти вместе со счётчиком ссылок
+template <typename T, typename Policy, typename... Args>
+ShrdPtr<T, Policy> MakeShrdWithPolicy(Args&&... args) {
+    auto counter = new InplaceRefCounter<T, Policy>();
+    T* object;
+    try {
+        object = counter->Construct(std::forward<Args>(args)...);
+    } catch (...) {
+        delete counter;
+        throw;
+    }
+    return ShrdPtr<T, Policy>(object, counter);
+}
+
+template <typename T, typename... Args>
+ShrdPtr<T> MakeShrd(Args&&... args) {
+    return MakeShrdWithPolicy<T, SingleThreadPolicy>(std::forward<Args>(args)...);
+}
+
+template <typename T, typename... Args>
+AtomicShrdPtr<T> MakeAtomicShrd(Args&&... args) {
+    return MakeShrdWithPolicy<T, AtomicPolicy>(std::forward<Args>(args)...);
+}
+
+// Как MakeShrd, но объект вместе со счётчиком размещается в resource.
+// resource должен пережить последний ShrdPtr и WeekPtr на объект
+template <typename T, typename Policy, typename... Args>
+ShrdPtr<T, Policy> AllocateShrdWithPolicy(MemoryResource* resource, Args&&... args) {
+    using Block = ResourceRefCounter<T, Policy>;
+    void* memory = AllocateFrom(resource, sizeof(Block), alignof(Block));
+    Block* counter = ::new (memory) Block(resource);
+    T* object;
+    try {
+        object = counter->Construct(std::forward<Args>(args)...);
+    } catch (...) {
+        counter->~Block();
+        DeallocateFrom(resource, memory, sizeof(Block), alignof(Block));
+        throw;
+    }
+    return ShrdPtr<T, Policy>(object, counter);
+}
+
+template <typename T, typename... Args>
+ShrdPtr<T> AllocateShrd(MemoryResource* resource, Args&&... args) {
+    return AllocateShrdWithPolicy<T, SingleThreadPolicy>(resource, std::forward<Args>(args)...);
+}
 #endif //SHRDPTR_H
\ No newline at end of file
@@ -1,58 +1,66 @@
 #ifndef WEEKPTR_H
 #define WEEKPTR_H
 
-template <typename T>
-class ShrdPtr;
+#include "RefCounter.h"
 
-template <typename T>
+#include <stdexcept>
+
+template <typename T, typename Policy>
 class WeekPtr {
 private:
     T* ptr;
-    typename ShrdPtr<T>::RefCounter* refCounter;
+    BasicRefCounter<Policy>* refCounter;
+
+    void release() {
+        if (refCounter) {
+            refCounter->ReleaseWeak();
+        }
+    }
+
+    T* checkedGet() const {
+        if (expired()) {
+            throw std::runtime_error("Trying to dereference a null WeekPtr");
+        }
+        return ptr;
+    }
 
 public:
     WeekPtr() : ptr(nullptr), refCounter(nullptr) {}
 
-    WeekPtr(const ShrdPtr<T>& other) : ptr(other.Get()), refCounter(other.getRefCounter()) {
+    WeekPtr(const ShrdPtr<T, Policy>& other) : ptr(other.ptr), refCounter(other.refCounter) {
         if (refCounter) {
-            refCounter->weekPtrs.insert(this);
+            refCounter->AddWeak();
+        }
+    }
+
+    WeekPtr(const WeekPtr& other) : ptr(other.ptr), refCounter(other.refCounter) {
+        if (refCounter) {
+            refCounter->AddWeak();
         }
     }
 
     WeekPtr& operator=(const WeekPtr& other) {
         if (this != &other) {
-            if (refCounter) {
-                refCounter->weekPtrs.erase(this);
+            if (other.refCounter) {
+                other.refCounter->AddWeak();
             }
+            release();
             ptr = other.ptr;
             refCounter = other.refCounter;
-            if (refCounter) {
-                refCounter->weekPtrs.insert(this);
-            }
         }
         return *this;
     }
 
     WeekPtr(WeekPtr&& other) noexcept : ptr(other.ptr), refCounter(other.refCounter) {
-        if (refCounter) {
-            refCounter->weekPtrs.erase(&other);
-            refCounter->weekPtrs.insert(this);
-        }
         other.ptr = nullptr;
         other.refCounter = nullptr;
     }
 
     WeekPtr& operator=(WeekPtr&& other) noexcept {
         if (this != &other) {
-            if (refCounter) {
-                refCounter->weekPtrs.erase(this);
-            }
+            release();
             ptr = other.ptr;
             refCounter = other.refCounter;
-            if (refCounter) {
-                refCounter->weekPtrs.erase(&other);
-                refCounter->weekPtrs.insert(this);
-            }
             other.ptr = nullptr;
             other.refCounter = nullptr;
         }
@@ -60,57 +68,37 @@ public:
     }
 
     ~WeekPtr() {
-        if (refCounter) {
-            refCounter->weekPtrs.erase(this);
-        }
+        release();
     }
 
     T& operator*() {
-        if (!ptr) {
-            throw std::runtime_error("Trying to dereference a null WeekPtr");
-        }
-        return *ptr;
+        return *checkedGet();
     }
 
     const T& operator*() const {
-        if (!ptr) {
-            throw std::runtime_error("Trying to dereference a null WeekPtr");
-        }
-        return *ptr;
+        return *checkedGet();
     }
 
     T* operator->() {
-        if (!ptr) {
-            throw std::runtime_error("Trying to dereference a null WeekPtr");
-        }
-        return ptr;
+        return checkedGet();
     }
 
     const T* operator->() const {
-        if (!ptr) {
-            throw std::runtime_error("Trying to dereference a null WeekPtr");
-        }
-        return ptr;
+        return checkedGet();
     }
 
-    bool expired() const { return !refCounter || refCounter->count == 0; }
+    bool expired() const { return !refCounter || refCounter->GetStrongCount() == 0; }
 
-    ShrdPtr<T> lock() const {
-        if (expired()) {
-            return ShrdPtr<T>();
-        } else {
-            return ShrdPtr<T>(*this);
-        }
+    ShrdPtr<T, Policy> lock() const {
+        return ShrdPtr<T, Policy>(*this);
     }
 
-    void invalidate() {
-        if(!ptr) {
-            throw std::runtime_error("Trying to dereference a null WeekPtr");
-        }
+    void reset() {
+        release();
         ptr = nullptr;
         refCounter = nullptr;
     }
 
-    friend class ShrdPtr<T>;
+    friend class ShrdPtr<T, Policy>;
 };
 #endif // WEEKPTR_H
\ No newline at end of file
@@ -0,0 +1,149 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "DynamicArray.h"
+#include "DequeSequence.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Пул потоков фиксированного размера. ParallelFor делит диапазон на блоки,
+// вызывающий поток тоже обрабатывает блоки, поэтому вложенные вызовы не блокируют пул
+class ThreadPool {
+private:
+    DynamicArray<std::thread> workers;
+    DequeSequence<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void workerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                available.wait(lock, [this] { return stopping || tasks.GetLength() > 0; });
+                if (tasks.GetLength() == 0) {
+                    return;
+                }
+                task = std::move(tasks.UncheckedGet(0));
+                tasks.PopFront();
+            }
+            task();
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t threadCount = DefaultThreadCount()) : stopping(false) {
+        workers.Reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers.Emplace([this] { workerLoop(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Рабочих потоков на один меньше, чем ядер: вызывающий поток тоже выполняет работу
+    static size_t DefaultThreadCount() {
+        size_t cores = std::thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 0;
+    }
+
+    static ThreadPool& Instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    size_t GetThreadCount() const {
+        return workers.GetSize();
+    }
+
+    void Submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.PushBack(std::move(task));
+        }
+        available.notify_one();
+    }
+
+    // Вызывает body(from, to) для блоков [begin, end) размером не больше grain.
+    // Первое исключение из body пробрасывается вызывающему после завершения всех блоков.
+    template <typename Body>
+    void ParallelFor(size_t begin, size_t end, size_t grain, const Body& body) {
+        if (begin >= end) {
+            return;
+        }
+        if (grain == 0) {
+            grain = 1;
+        }
+        size_t chunks = (end - begin + grain - 1) / grain;
+        if (chunks == 1 || workers.GetSize() == 0) {
+            body(begin, end);
+            return;
+        }
+
+        struct State {
+            std::atomic<size_t> next{0};
+            std::atomic<size_t> completed{0};
+            std::mutex mutex;
+            std::condition_variable done;
+            std::exception_ptr error;
+        };
+        auto state = std::make_shared<State>();
+
+        // Блок берётся только пока не все блоки розданы, поэтому опоздавшие задачи
+        // не обращаются к body после возврата из ParallelFor
+        auto drain = [state, begin, end, grain, chunks, &body]() {
+            while (true) {
+                size_t chunk = state->next.fetch_add(1);
+                if (chunk >= chunks) {
+                    return;
+                }
+                size_t from = begin + chunk * grain;
+                size_t to = end - from > grain ? from + grain : end;
+                try {
+                    body(from, to);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (!state->error) {
+                        state->error = std::current_exception();
+                    }
+                }
+                if (state->completed.fetch_add(1) + 1 == chunks) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->done.notify_all();
+                }
+            }
+        };
+
+        size_t helpers = chunks - 1 < workers.GetSize() ? chunks - 1 : workers.GetSize();
+        for (size_t i = 0; i < helpers; ++i) {
+            Submit(drain);
+        }
+        drain();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done.wait(lock, [&state, chunks] { return state->completed.load() == chunks; });
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+};
+
+#endif //THREADPOOL_H
@@ -3,106 +3,136 @@
 
 #include "Sequence.h"
 #include "DynamicArray.h"
-#include <iostream>
+#include "ArraySpan.h"
 
 template <typename T>
 class ArraySequence : public Sequence<T> {
 private:
-    ShrdPtr<DynamicArray<T>> array;
+    IntrusivePtr<DynamicArray<T>> array;
 
     void EnsureCapacity(size_t requiredCapacity) {
-        if (array->GetSize() < requiredCapacity) {
-            size_t newCapacity = array->GetSize() * 2 + 1;
+        if (array->GetCapacity() < requiredCapacity) {
+            size_t newCapacity = array->GetCapacity() * 2 + 1;
             if (newCapacity < requiredCapacity) {
                 newCapacity = requiredCapacity;
             }
-            array->Resize(newCapacity);
+            array->Reserve(newCapacity);
         }
     }
 public:
-    ArraySequence() : array(new DynamicArray<T>(0)) {}
-    ArraySequence(ShrdPtr<DynamicArray<T>>&& arr) : array(std::move(arr)) {}
-    ArraySequence(T* items, size_t count) : array(new DynamicArray<T>(items, count)) {}
-    ArraySequence(const ArraySequence<T>& arraySequence) : array(new DynamicArray<T>(*arraySequence.array)) {}
-    ArraySequence(const ShrdPtr<DynamicArray<T>>& otherArray) : array(otherArray) {}
+    ArraySequence() : array(MakeIntrusive<DynamicArray<T>>()) {}
+    ArraySequence(IntrusivePtr<DynamicArray<T>>&& arr) : array(std::move(arr)) {}
+    ArraySequence(const T* items, size_t count) : array(MakeIntrusive<DynamicArray<T>>(items, count)) {}
+    ArraySequence(const ArraySequence<T>& arraySequence) : array(MakeIntrusive<DynamicArray<T>>(*arraySequence.array)) {}
+    ArraySequence(const IntrusivePtr<DynamicArray<T>>& otherArray) : array(otherArray) {}
 
 
     ShrdPtr<Sequence<T>>  Append(const T& item) const override {
-        ShrdPtr<DynamicArray<T>> newArray(new DynamicArray<T>(this->array->GetSize() + 1));
+        auto newArray = MakeIntrusive<DynamicArray<T>>();
+        newArray->Reserve(this->array->GetSize() + 1);
         for (size_t i = 0; i < this->array->GetSize(); ++i) {
-            newArray->Set(i, this->array->Get(i));
+            newArray->PushBack(this->array->UncheckedGet(i));
         }
-        newArray->Set(newArray->GetSize() - 1, item);
-        return ShrdPtr<Sequence<T>>(new ArraySequence<T>(newArray));
+        newArray->PushBack(item);
+        return MakeShrd<ArraySequence<T>>(newArray);
     }
 
     ShrdPtr<Sequence<T>> Prepend(const T& item) const override {
-        ShrdPtr<DynamicArray<T>> newArray(new DynamicArray<T>(this->array->GetSize() + 1));
-        newArray->Set(0, item);
+        auto newArray = MakeIntrusive<DynamicArray<T>>();
+        newArray->Reserve(this->array->GetSize() + 1);
+        newArray->PushBack(item);
         for (size_t i = 0; i < this->array->GetSize(); ++i) {
-            newArray->Set(i + 1, this->array->Get(i));
+            newArray->PushBack(this->array->UncheckedGet(i));
         }
-        return ShrdPtr<Sequence<T>>(new ArraySequence<T>(std::move(newArray)));
+        return MakeShrd<ArraySequence<T>>(std::move(newArray));
     }
 
     ShrdPtr<Sequence<T>> InsertAt(const T& item, size_t index) const override {
-        ShrdPtr<DynamicArray<T>> newArray(new DynamicArray<T>(this->array->GetSize() + 1));
+        if (index > this->array->GetSize()) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        auto newArray = MakeIntrusive<DynamicArray<T>>();
+        newArray->Reserve(this->array->GetSize() + 1);
         for (size_t i = 0; i < index; ++i) {
-            newArray->Set(i, this->array->Get(i));
+            newArray->PushBack(this->array->UncheckedGet(i));
         }
-        newArray->Set(index, item);
+        newArray->PushBack(item);
         for (size_t i = index; i < this->array->GetSize(); ++i) {
-            newArray->Set(i + 1, this->array->Get(i));
+            newArray->PushBack(this->array->UncheckedGet(i));
         }
-        return ShrdPtr<Sequence<T>>(new ArraySequence<T>(std::move(newArray)));
+        return MakeShrd<ArraySequence<T>>(std::move(newArray));
     }
 
     ShrdPtr<Sequence<T>> GetSubsequence(size_t startIndex, size_t endIndex) const override {
         if (startIndex < 0 || startIndex >= array->GetSize() || endIndex < 0 || endIndex >= array->GetSize() || startIndex > endIndex) {
             throw std::out_of_range("IndexOutOfRange");
         }
-        ShrdPtr<DynamicArray<T>> newArray(new DynamicArray<T>(endIndex - startIndex + 1));
+        auto newArray = MakeIntrusive<DynamicArray<T>>();
+        newArray->Reserve(endIndex - startIndex + 1);
         for (size_t i = startIndex; i <= endIndex; i++) {
-            newArray->Set(i - startIndex, array->Get(i));
+            newArray->PushBack(array->UncheckedGet(i));
         }
-        return ShrdPtr<Sequence<T>>(new ArraySequence<T>(std::move(newArray)));
+        return MakeShrd<ArraySequence<T>>(std::move(newArray));
     }
 
     T GetFirst() const override {
         if (array->GetSize() == 0) {
             throw std::out_of_range("IndexOutOfRange");
         }
-        return array->Get(0);
+        return array->UncheckedGet(0);
     }
 
     T GetLast() const override {
         if (array->GetSize() == 0) {
             throw std::out_of_range("IndexOutOfRange");
         }
-        return array->Get(array->GetSize() - 1);
+        return array->UncheckedGet(array->GetSize() - 1);
     }
 
     const T& Get(size_t index) const override {
-        if (index < 0 || index >= array->GetSize()) {
-            std::cerr << "Error in get: Index " << index << " out of range [0, " << array->GetSize() - 1 << "]" << std::endl;
+        if (index >= array->GetSize()) {
             throw std::out_of_range("Index out of range");
         }
-        return array->Get(index);
+        return array->UncheckedGet(index);
     }
     T& Get(size_t index) override {
-        if (index < 0 || index >= array->GetSize()) {
-            std::cerr << "Error in get: Index " << index << " out of range [0, " << array->GetSize() - 1 << "]" << std::endl;
+        if (index >= array->GetSize()) {
             throw std::out_of_range("Index out of range");
         }
-        return array->Get(index);
+        return array->UncheckedGet(index);
     }
 
     void Set(size_t index, const T& value) override {
-        if (index < 0 || index >= array->GetSize()) {
-            std::cerr << "Error in set: Index " << index << " out of range [0, " << array->GetSize() - 1 << "]" << std::endl;
+        if (index >= array->GetSize()) {
             throw std::out_of_range("Index out of range");
         }
-        array->Set(index, value);
+        array->UncheckedGet(index) = value;
+    }
+
+    // Доступ без проверки границ — только для внутренних циклов, где индекс уже проверен
+    T& UncheckedGet(size_t index) {
+        return array->UncheckedGet(index);
+    }
+
+    const T& UncheckedGet(size_t index) const {
+        return array->UncheckedGet(index);
+    }
+
+    // Указатель и итераторы действительны до следующего изменения размера
+    T* Data() { return array->Data(); }
+    const T* Data() const { return array->Data(); }
+
+    T* begin() { return array->begin(); }
+    T* end() { return array->end(); }
+    const T* begin() const { return array->begin(); }
+    const T* end() const { return array->end(); }
+
+    ArraySpan<T> AsSpan() {
+        return ArraySpan<T>(array->Data(), array->GetSize());
+    }
+
+    ArraySpan<const T> AsSpan() const {
+        return ArraySpan<const T>(array->Data(), array->GetSize());
     }
 
     size_t GetLength() const override {
@@ -110,7 +140,7 @@ public:
     }
 
     ShrdPtr<Sequence<T>> Copy() const override {
-        return ShrdPtr<Sequence<T>>(new ArraySequence<T>(this->array));
+        return MakeShrd<ArraySequence<T>>(this->array);
     }
 
     T& operator[](size_t index) override {
@@ -124,10 +154,11 @@ public:
         if (index < 0 || index >= array->GetSize()) {
             throw std::out_of_range("Index out of range");
         }
-        ShrdPtr<DynamicArray<T>> newArray(new DynamicArray<T>(array->GetSize() - 1));
-        for (size_t i = 0, j = 0; i < array->GetSize(); ++i) {
+        auto newArray = MakeIntrusive<DynamicArray<T>>();
+        newArray->Reserve(array->GetSize() - 1);
+        for (size_t i = 0; i < array->GetSize(); ++i) {
             if (i != index) {
-                newArray->Set(j++, array->Get(i));
+                newArray->PushBack(array->UncheckedGet(i));
             }
         }
         array = newArray;
@@ -138,16 +169,18 @@ public:
             return *this; // Защита от самоприсваивания
         }
         // Копируем элементы из другого Sequence
-        this->array = ShrdPtr<DynamicArray<T>>(new DynamicArray<T>(other->GetLength()));
+        auto newArray = MakeIntrusive<DynamicArray<T>>();
+        newArray->Reserve(other->GetLength());
         for (size_t i = 0; i < other->GetLength(); ++i) {
-            this->array->Set(i, other->Get(i));
+            newArray->PushBack(other->Get(i));
         }
+        this->array = std::move(newArray);
         return *this;
     }
 
     bool Contains(const T& item) const {
-        for (size_t i = 0; i < this->GetLength(); ++i) {
-            if (this->operator[](i) == item) {
+        for (const T& current : *this) {
+            if (current == item) {
                 return true;
             }
         }
@@ -155,8 +188,20 @@ public:
     }
 
     void Add(const T& item) {
-        array->Resize(array->GetSize() + 1);
-        array->Set(array->GetSize() - 1, item);
+        array->PushBack(item);
+    }
+
+    void Add(T&& item) {
+        array->PushBack(std::move(item));
+    }
+
+    template <typename... Args>
+    T& Emplace(Args&&... args) {
+        return array->Emplace(std::forward<Args>(args)...);
+    }
+
+    void Reserve(size_t capacity) {
+        array->Reserve(capacity);
     }
 
     ~ArraySequence() = default;
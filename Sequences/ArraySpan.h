@@ -0,0 +1,49 @@
+#ifndef ARRAYSPAN_H
+#define ARRAYSPAN_H
+
+#include <stdexcept>
+#include <type_traits>
+
+// Невладеющее представление непрерывного участка памяти (аналог std::span)
+template <typename T>
+class ArraySpan {
+private:
+    T* data;
+    size_t length;
+
+public:
+    using Iterator = T*;
+
+    ArraySpan() : data(nullptr), length(0) {}
+    ArraySpan(T* data, size_t length) : data(data), length(length) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U(*)[], T(*)[]>::value>>
+    ArraySpan(const ArraySpan<U>& other) : data(other.Data()), length(other.GetLength()) {}
+
+    T* Data() const { return data; }
+    size_t GetLength() const { return length; }
+    bool IsEmpty() const { return length == 0; }
+
+    T& Get(size_t index) const {
+        if (index >= length) {
+            throw std::out_of_range("Index out of range");
+        }
+        return data[index];
+    }
+
+    T& operator[](size_t index) const {
+        return data[index];
+    }
+
+    ArraySpan<T> Subspan(size_t offset, size_t count) const {
+        if (offset > length || count > length - offset) {
+            throw std::out_of_range("Index out of range");
+        }
+        return ArraySpan<T>(data + offset, count);
+    }
+
+    Iterator begin() const { return data; }
+    Iterator end() const { return data + length; }
+};
+
+#endif //ARRAYSPAN_H
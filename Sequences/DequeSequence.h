@@ -0,0 +1,346 @@
+#ifndef DEQUESEQUENCE_H
+#define DEQUESEQUENCE_H
+
+#include "Sequence.h"
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Последовательность из блоков фиксированного размера: добавление и удаление с обоих концов
+// за амортизированное O(1), элементы никогда не перемещаются при росте
+template <typename T>
+class DequeSequence : public Sequence<T> {
+private:
+    static constexpr size_t floorPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result * 2 <= value) {
+            result *= 2;
+        }
+        return result;
+    }
+
+    static constexpr size_t chunkSize = sizeof(T) <= 4096 / 16 ? floorPowerOfTwo(4096 / sizeof(T)) : 16;
+
+    T** map;
+    size_t mapCapacity;
+    size_t start;
+    size_t length;
+
+    static T* allocateChunk() {
+        return std::allocator<T>().allocate(chunkSize);
+    }
+
+    static void deallocateChunk(T* chunk) {
+        std::allocator<T>().deallocate(chunk, chunkSize);
+    }
+
+    T* slot(size_t position) const {
+        return map[position / chunkSize] + position % chunkSize;
+    }
+
+    // Пересобирает карту блоков так, чтобы с обеих сторон появилось свободное место;
+    // сами блоки при этом не перемещаются
+    void rebuildMap() {
+        size_t firstChunk = start / chunkSize;
+        size_t usedChunks = length == 0 ? 1 : (start + length - 1) / chunkSize - firstChunk + 1;
+        size_t newCapacity = mapCapacity;
+        if ((usedChunks + 2) * 2 > mapCapacity) {
+            newCapacity = (usedChunks + 2) * 2;
+        }
+        if (newCapacity < 8) {
+            newCapacity = 8;
+        }
+
+        T** newMap = new T*[newCapacity]();
+        size_t newFirstChunk = (newCapacity - usedChunks) / 2;
+        for (size_t i = 0; i < mapCapacity; ++i) {
+            if (i >= firstChunk && i < firstChunk + usedChunks) {
+                newMap[newFirstChunk + i - firstChunk] = map[i];
+            } else if (map[i]) {
+                deallocateChunk(map[i]);
+            }
+        }
+        delete[] map;
+        map = newMap;
+        mapCapacity = newCapacity;
+        start = newFirstChunk * chunkSize + start % chunkSize;
+    }
+
+    T* prepareBackSlot() {
+        size_t position = start + length;
+        if (position / chunkSize >= mapCapacity) {
+            rebuildMap();
+            position = start + length;
+        }
+        T*& chunk = map[position / chunkSize];
+        if (!chunk) {
+            chunk = allocateChunk();
+        }
+        return chunk + position % chunkSize;
+    }
+
+    T* prepareFrontSlot() {
+        if (start == 0) {
+            rebuildMap();
+        }
+        size_t position = start - 1;
+        T*& chunk = map[position / chunkSize];
+        if (!chunk) {
+            chunk = allocateChunk();
+        }
+        return chunk + position % chunkSize;
+    }
+
+    void checkIndex(size_t index) const {
+        if (index >= length) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+    }
+
+public:
+    template <bool IsConst>
+    class BasicIterator {
+    private:
+        using Owner = std::conditional_t<IsConst, const DequeSequence<T>, DequeSequence<T>>;
+        Owner* owner;
+        size_t index;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        BasicIterator() : owner(nullptr), index(0) {}
+        BasicIterator(Owner* owner, size_t index) : owner(owner), index(index) {}
+
+        reference operator*() const { return owner->UncheckedGet(index); }
+        pointer operator->() const { return &owner->UncheckedGet(index); }
+        reference operator[](difference_type offset) const { return owner->UncheckedGet(index + offset); }
+
+        BasicIterator& operator++() { ++index; return *this; }
+        BasicIterator operator++(int) { BasicIterator copy = *this; ++index; return copy; }
+        BasicIterator& operator--() { --index; return *this; }
+        BasicIterator operator--(int) { BasicIterator copy = *this; --index; return copy; }
+        BasicIterator& operator+=(difference_type offset) { index += offset; return *this; }
+        BasicIterator& operator-=(difference_type offset) { index -= offset; return *this; }
+        BasicIterator operator+(difference_type offset) const { return BasicIterator(owner, index + offset); }
+        BasicIterator operator-(difference_type offset) const { return BasicIterator(owner, index - offset); }
+        friend BasicIterator operator+(difference_type offset, const BasicIterator& it) { return it + offset; }
+        difference_type operator-(const BasicIterator& other) const {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const BasicIterator& other) const { return index == other.index; }
+        bool operator!=(const BasicIterator& other) const { return index != other.index; }
+        bool operator<(const BasicIterator& other) const { return index < other.index; }
+        bool operator>(const BasicIterator& other) const { return index > other.index; }
+        bool operator<=(const BasicIterator& other) const { return index <= other.index; }
+        bool operator>=(const BasicIterator& other) const { return index >= other.index; }
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    DequeSequence() : map(nullptr), mapCapacity(0), start(0), length(0) {}
+
+    DequeSequence(const T* items, size_t count) : DequeSequence() {
+        for (size_t i = 0; i < count; ++i) {
+            PushBack(items[i]);
+        }
+    }
+
+    DequeSequence(const DequeSequence<T>& other) : DequeSequence() {
+        for (size_t i = 0; i < other.length; ++i) {
+            PushBack(other.UncheckedGet(i));
+        }
+    }
+
+    DequeSequence(DequeSequence<T>&& other) noexcept
+        : map(other.map), mapCapacity(other.mapCapacity), start(other.start), length(other.length) {
+        other.map = nullptr;
+        other.mapCapacity = 0;
+        other.start = 0;
+        other.length = 0;
+    }
+
+    DequeSequence<T>& operator=(DequeSequence<T> other) {
+        std::swap(map, other.map);
+        std::swap(mapCapacity, other.mapCapacity);
+        std::swap(start, other.start);
+        std::swap(length, other.length);
+        return *this;
+    }
+
+    ~DequeSequence() override {
+        Clear();
+        for (size_t i = 0; i < mapCapacity; ++i) {
+            if (map[i]) {
+                deallocateChunk(map[i]);
+            }
+        }
+        delete[] map;
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        T* place = prepareBackSlot();
+        ::new (static_cast<void*>(place)) T(std::forward<Args>(args)...);
+        ++length;
+        return *place;
+    }
+
+    template <typename... Args>
+    T& EmplaceFront(Args&&... args) {
+        T* place = prepareFrontSlot();
+        ::new (static_cast<void*>(place)) T(std::forward<Args>(args)...);
+        --start;
+        ++length;
+        return *place;
+    }
+
+    void PushBack(const T& item) { EmplaceBack(item); }
+    void PushBack(T&& item) { EmplaceBack(std::move(item)); }
+    void PushFront(const T& item) { EmplaceFront(item); }
+    void PushFront(T&& item) { EmplaceFront(std::move(item)); }
+
+    void Add(const T& item) { EmplaceBack(item); }
+
+    void PopBack() {
+        if (length == 0) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        --length;
+        slot(start + length)->~T();
+    }
+
+    void PopFront() {
+        if (length == 0) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        slot(start)->~T();
+        ++start;
+        --length;
+    }
+
+    void Clear() {
+        for (size_t i = 0; i < length; ++i) {
+            slot(start + i)->~T();
+        }
+        length = 0;
+    }
+
+    ShrdPtr<Sequence<T>> Append(const T& item) const override {
+        auto result = MakeShrd<DequeSequence<T>>(*this);
+        result->PushBack(item);
+        return result;
+    }
+
+    ShrdPtr<Sequence<T>> Prepend(const T& item) const override {
+        auto result = MakeShrd<DequeSequence<T>>(*this);
+        result->PushFront(item);
+        return result;
+    }
+
+    ShrdPtr<Sequence<T>> InsertAt(const T& item, size_t index) const override {
+        if (index > length) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        auto result = MakeShrd<DequeSequence<T>>();
+        for (size_t i = 0; i < index; ++i) {
+            result->PushBack(UncheckedGet(i));
+        }
+        result->PushBack(item);
+        for (size_t i = index; i < length; ++i) {
+            result->PushBack(UncheckedGet(i));
+        }
+        return result;
+    }
+
+    ShrdPtr<Sequence<T>> GetSubsequence(size_t startIndex, size_t endIndex) const override {
+        if (startIndex >= length || endIndex >= length || startIndex > endIndex) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        auto result = MakeShrd<DequeSequence<T>>();
+        for (size_t i = startIndex; i <= endIndex; ++i) {
+            result->PushBack(UncheckedGet(i));
+        }
+        return result;
+    }
+
+    T GetFirst() const override {
+        checkIndex(0);
+        return UncheckedGet(0);
+    }
+
+    T GetLast() const override {
+        checkIndex(0);
+        return UncheckedGet(length - 1);
+    }
+
+    const T& Get(size_t index) const override {
+        checkIndex(index);
+        return UncheckedGet(index);
+    }
+
+    T& Get(size_t index) override {
+        checkIndex(index);
+        return UncheckedGet(index);
+    }
+
+    T& UncheckedGet(size_t index) {
+        return *slot(start + index);
+    }
+
+    const T& UncheckedGet(size_t index) const {
+        return *slot(start + index);
+    }
+
+    void Set(size_t index, const T& value) override {
+        checkIndex(index);
+        UncheckedGet(index) = value;
+    }
+
+    size_t GetLength() const override {
+        return length;
+    }
+
+    ShrdPtr<Sequence<T>> Copy() const override {
+        return MakeShrd<DequeSequence<T>>(*this);
+    }
+
+    // Сдвигает к удаляемому месту ближайший к нему конец последовательности
+    void RemoveAt(size_t index) override {
+        checkIndex(index);
+        if (index < length / 2) {
+            for (size_t i = index; i > 0; --i) {
+                UncheckedGet(i) = std::move(UncheckedGet(i - 1));
+            }
+            PopFront();
+        } else {
+            for (size_t i = index; i + 1 < length; ++i) {
+                UncheckedGet(i) = std::move(UncheckedGet(i + 1));
+            }
+            PopBack();
+        }
+    }
+
+    T& operator[](size_t index) override {
+        return Get(index);
+    }
+
+    const T& operator[](size_t index) const override {
+        return Get(index);
+    }
+
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, length); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, length); }
+};
+
+#endif //DEQUESEQUENCE_H
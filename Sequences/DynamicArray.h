@@ -1,37 +1,221 @@
 #ifndef DYNAMICARRAY_H
 #define DYNAMICARRAY_H
 
+#include "IntrusivePtr.h"
+#include "MemoryResource.h"
+#include "AllocationStats.h"
 #include <stdexcept>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 template <typename T>
-class DynamicArray {
+class DynamicArray : public RefCountedBase {
 private:
     T* items;
     size_t size;
+    size_t capacity;
+    // nullptr — обычная куча (malloc/new), иначе вся память берётся из resource
+    MemoryResource* resource;
+
+    // Тривиально копируемые элементы живут в malloc-памяти и переносятся через memcpy/realloc
+    static constexpr bool isTrivial = std::is_trivially_copyable<T>::value &&
+                                      alignof(T) <= alignof(std::max_align_t);
+    static constexpr bool isOverAligned = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    T* allocate(size_t count) const {
+        if (count == 0) {
+            return nullptr;
+        }
+        if (count > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::length_error("DynamicArray is too large");
+        }
+        void* memory;
+        if (resource) {
+            memory = resource->Allocate(count * sizeof(T), alignof(T));
+        } else if constexpr (isTrivial) {
+            memory = std::malloc(count * sizeof(T));
+            if (!memory) {
+                throw std::bad_alloc();
+            }
+        } else if constexpr (isOverAligned) {
+            memory = ::operator new(count * sizeof(T), std::align_val_t(alignof(T)));
+        } else {
+            memory = ::operator new(count * sizeof(T));
+        }
+        AllocationStats::RecordAllocation(AllocationCategory::DynamicArray, count * sizeof(T));
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* memory, size_t count) const {
+        if (!memory) {
+            return;
+        }
+        AllocationStats::RecordDeallocation(AllocationCategory::DynamicArray, count * sizeof(T));
+        if (resource) {
+            resource->Deallocate(memory, count * sizeof(T), alignof(T));
+        } else if constexpr (isTrivial) {
+            std::free(memory);
+        } else if constexpr (isOverAligned) {
+            ::operator delete(memory, std::align_val_t(alignof(T)));
+        } else {
+            ::operator delete(memory);
+        }
+    }
+
+    static void destroy(T* first, T* last) {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (; first != last; ++first) {
+                first->~T();
+            }
+        }
+    }
+
+    // Переносит элементы в новый буфер: move, если он не бросает исключений, иначе copy
+    static void relocate(T* from, size_t count, T* to) {
+        if constexpr (isTrivial) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+            }
+        } else if constexpr (std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value) {
+            std::uninitialized_move(from, from + count, to);
+        } else {
+            std::uninitialized_copy(from, from + count, to);
+        }
+    }
+
+    static void copyConstruct(const T* from, size_t count, T* to) {
+        if constexpr (isTrivial) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+            }
+        } else {
+            std::uninitialized_copy(from, from + count, to);
+        }
+    }
+
+    void reallocate(size_t newCapacity) {
+        // realloc компилируется только для тривиальных T: для остальных он был бы ошибкой (и -Wclass-memaccess)
+        if constexpr (isTrivial) {
+            if (!resource) {
+                if (newCapacity == 0) {
+                    if (items) {
+                        AllocationStats::RecordDeallocation(AllocationCategory::DynamicArray, capacity * sizeof(T));
+                    }
+                    std::free(items);
+                    items = nullptr;
+                } else {
+                    if (newCapacity > static_cast<size_t>(-1) / sizeof(T)) {
+                        throw std::length_error("DynamicArray is too large");
+                    }
+                    void* memory = std::realloc(items, newCapacity * sizeof(T));
+                    if (!memory) {
+                        throw std::bad_alloc();
+                    }
+                    items = static_cast<T*>(memory);
+                    if (capacity > 0) {
+                        AllocationStats::RecordDeallocation(AllocationCategory::DynamicArray, capacity * sizeof(T));
+                    }
+                    AllocationStats::RecordAllocation(AllocationCategory::DynamicArray, newCapacity * sizeof(T));
+                }
+                capacity = newCapacity;
+                return;
+            }
+        }
+        T* newItems = allocate(newCapacity);
+        try {
+            relocate(items, size, newItems);
+        } catch (...) {
+            deallocate(newItems, newCapacity);
+            throw;
+        }
+        destroy(items, items + size);
+        deallocate(items, capacity);
+        items = newItems;
+        capacity = newCapacity;
+    }
+
+    void grow(size_t requiredCapacity) {
+        if (requiredCapacity <= capacity) {
+            return;
+        }
+        size_t newCapacity = capacity * 2;
+        if (newCapacity < requiredCapacity) {
+            newCapacity = requiredCapacity;
+        }
+        reallocate(newCapacity);
+    }
 
 public:
 
-    DynamicArray(size_t size) : size(size), items(new T[size]) {
-        for (size_t i = 0; i < size; ++i) {
-            items[i] = T();
+    DynamicArray() : items(nullptr), size(0), capacity(0), resource(nullptr) {}
+
+    DynamicArray(size_t size, MemoryResource* resource = nullptr) : items(nullptr), size(0), capacity(0), resource(resource) {
+        items = allocate(size);
+        capacity = size;
+        try {
+            std::uninitialized_value_construct(items, items + size);
+        } catch (...) {
+            deallocate(items, capacity);
+            throw;
         }
+        this->size = size;
     }
 
 
-    DynamicArray(T* items, size_t count) : size(count), items(new T[count]) {
-        for (size_t i = 0; i < count; ++i) {
-            this->items[i] = items[i];
+    DynamicArray(const T* items, size_t count, MemoryResource* resource = nullptr)
+        : items(nullptr), size(0), capacity(0), resource(resource) {
+        this->items = allocate(count);
+        capacity = count;
+        try {
+            copyConstruct(items, count, this->items);
+        } catch (...) {
+            deallocate(this->items, capacity);
+            throw;
         }
+        size = count;
     }
 
-    DynamicArray(const DynamicArray<T>& dynamicArray) : size(dynamicArray.size), items(new T[dynamicArray.size]) {
-        for (size_t i = 0; i < size; ++i) {
-            items[i] = dynamicArray.items[i];
+    // Копия всегда использует обычную кучу: она может пережить арену оригинала
+    DynamicArray(const DynamicArray<T>& dynamicArray) : DynamicArray(dynamicArray.items, dynamicArray.size) {}
+
+    DynamicArray(DynamicArray<T>&& other) noexcept
+        : items(other.items), size(other.size), capacity(other.capacity), resource(other.resource) {
+        other.items = nullptr;
+        other.size = 0;
+        other.capacity = 0;
+    }
+
+    DynamicArray<T>& operator=(const DynamicArray<T>& other) {
+        if (this != &other) {
+            DynamicArray<T> copy(other.items, other.size, resource);
+            Swap(copy);
         }
+        return *this;
+    }
+
+    DynamicArray<T>& operator=(DynamicArray<T>&& other) noexcept {
+        if (this != &other) {
+            destroy(items, items + size);
+            deallocate(items, capacity);
+            items = other.items;
+            size = other.size;
+            capacity = other.capacity;
+            resource = other.resource;
+            other.items = nullptr;
+            other.size = 0;
+            other.capacity = 0;
+        }
+        return *this;
     }
 
     ~DynamicArray() {
-        delete[] items;
+        destroy(items, items + size);
+        deallocate(items, capacity);
     }
 
 
@@ -39,6 +223,25 @@ public:
         return size;
     }
 
+    size_t GetCapacity() const {
+        return capacity;
+    }
+
+    MemoryResource* GetResource() const {
+        return resource;
+    }
+
+    // Байты самого массива, его буфера (по capacity) и памяти, которой владеют элементы
+    size_t MemoryUsage() const {
+        size_t total = sizeof(*this) + capacity * sizeof(T);
+        if constexpr (HasMemoryUsage<T>::value) {
+            for (size_t i = 0; i < size; ++i) {
+                total += OwnedMemoryUsage(items[i]);
+            }
+        }
+        return total;
+    }
+
     const T& Get(size_t index) const {
         if (index < 0 || index >= size) throw std::out_of_range("out_of_range");
         return items[index];
@@ -49,13 +252,71 @@ public:
         return items[index];
     }
 
-    void Set(size_t index, T value) {
+    T& UncheckedGet(size_t index) {
+        return items[index];
+    }
+
+    const T& UncheckedGet(size_t index) const {
+        return items[index];
+    }
+
+    T* Data() { return items; }
+    const T* Data() const { return items; }
+
+    T* begin() { return items; }
+    T* end() { return items + size; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + size; }
+
+    void Set(size_t index, const T& value) {
         if (index < 0 || index >= size) {
             throw std::out_of_range("IndexOutOfRange");
         }
         items[index] = value;
     }
 
+    void Set(size_t index, T&& value) {
+        if (index < 0 || index >= size) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        items[index] = std::move(value);
+    }
+
+    void Reserve(size_t newCapacity) {
+        if (newCapacity > capacity) {
+            reallocate(newCapacity);
+        }
+    }
+
+    template <typename... Args>
+    T& Emplace(Args&&... args) {
+        if (size == capacity) {
+            // Аргумент может ссылаться на элемент самого массива, поэтому сначала строим значение
+            T value(std::forward<Args>(args)...);
+            grow(size + 1);
+            ::new (static_cast<void*>(items + size)) T(std::move(value));
+        } else {
+            ::new (static_cast<void*>(items + size)) T(std::forward<Args>(args)...);
+        }
+        return items[size++];
+    }
+
+    void PushBack(const T& value) {
+        Emplace(value);
+    }
+
+    void PushBack(T&& value) {
+        Emplace(std::move(value));
+    }
+
+    void PopBack() {
+        if (size == 0) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        --size;
+        destroy(items + size, items + size + 1);
+    }
+
     void Resize(size_t newSize) {
         if (newSize <= 0) {
             throw std::length_error("Invalid new size");
@@ -63,16 +324,28 @@ public:
         if (newSize == size) {
             return;
         }
-        T* newItems = new T[newSize];
-        size_t minSize = (newSize > size) ? size : newSize;
-        for (size_t i = 0; i < minSize; ++i) {
-            newItems[i] = items[i];
+        if (newSize < size) {
+            destroy(items + newSize, items + size);
+            size = newSize;
+            return;
         }
-        delete[] items;
-        items = newItems;
+        grow(newSize);
+        std::uninitialized_value_construct(items + size, items + newSize);
         size = newSize;
     }
 
+    void Clear() {
+        destroy(items, items + size);
+        size = 0;
+    }
+
+    void Swap(DynamicArray<T>& other) noexcept {
+        std::swap(items, other.items);
+        std::swap(size, other.size);
+        std::swap(capacity, other.capacity);
+        std::swap(resource, other.resource);
+    }
+
     T &operator [] (size_t index) {
         if (index < 0 || index >= size)
             throw std::out_of_range("IndexOutOfRange");
@@ -2,41 +2,70 @@
 #define LINKEDLIST_H
 
 #include "ShrdPtr.h"
+#include "IntrusivePtr.h"
+#include "MemoryResource.h"
+#include "AllocationStats.h"
+#include <new>
 #include <stdexcept>
 
 template <typename T>
-class Node {
+class Node : public RefCountedBase {
 public:
     T data;
-    ShrdPtr<Node<T>> next;
+    IntrusivePtr<Node<T>> next;
+    MemoryResource* resource;
 
-    Node(const T& data) : data(data) {}
+    Node(const T& data, MemoryResource* resource = nullptr) : data(data), resource(resource) {}
 };
 
+template <typename T>
+void DestroyIntrusive(Node<T>* node) {
+    MemoryResource* resource = node->resource;
+    AllocationStats::RecordDeallocation(AllocationCategory::ListNode, sizeof(Node<T>));
+    node->~Node();
+    DeallocateFrom(resource, node, sizeof(Node<T>), alignof(Node<T>));
+}
+
 template <typename T>
 class LinkedList {
 private:
-    ShrdPtr<Node<T>> head;
+    IntrusivePtr<Node<T>> head;
     int length;
+    MemoryResource* resource;
+
+    IntrusivePtr<Node<T>> createNode(const T& item) const {
+        void* memory = AllocateFrom(resource, sizeof(Node<T>), alignof(Node<T>));
+        try {
+            IntrusivePtr<Node<T>> node(::new (memory) Node<T>(item, resource));
+            AllocationStats::RecordAllocation(AllocationCategory::ListNode, sizeof(Node<T>));
+            return node;
+        } catch (...) {
+            DeallocateFrom(resource, memory, sizeof(Node<T>), alignof(Node<T>));
+            throw;
+        }
+    }
 
 public:
-    LinkedList() :  length(0) {}
+    LinkedList() :  length(0), resource(nullptr) {}
+
+    // Узлы списка выделяются из resource (например, из Pool с блоком sizeof(Node<T>))
+    explicit LinkedList(MemoryResource* resource) : length(0), resource(resource) {}
 
     LinkedList(const LinkedList& list) : LinkedList() {
-        ShrdPtr<Node<T>> current = list.head;
+        Node<T>* current = list.head.Get();
         while (current) {
             Append(current->data);
-            current = current->next;
+            current = current->next.Get();
         }
     }
 
-    LinkedList(const T* items, int count)  : length(0) {
+    LinkedList(const T* items, int count)  : length(0), resource(nullptr) {
         for (int i = 0; i < count; ++i) {
             Append(items[i]);
         }
     }
 
-    LinkedList(LinkedList&& other) noexcept : head(std::move(other.head)), length(other.length) {
+    LinkedList(LinkedList&& other) noexcept : head(std::move(other.head)), length(other.length), resource(other.resource) {
         other.length = 0;
     }
 
@@ -53,9 +82,9 @@ public:
         if (length == 0) {
             throw std::out_of_range("IndexOutOfRange");
         }
-        ShrdPtr<Node<T>> current = head;
+        Node<T>* current = head.Get();
         while (current && current->next) {
-            current = current->next;
+            current = current->next.Get();
         }
         return current->data;
     }
@@ -64,9 +93,9 @@ public:
         if (index < 0 || index >= length) {
             throw std::out_of_range("IndexOutOfRange");
         }
-        ShrdPtr<Node<T>> current = head;
+        Node<T>* current = head.Get();
         for (int i = 0; i < index; ++i) {
-            current = current->next;
+            current = current->next.Get();
         }
         return current->data;
     }
@@ -75,9 +104,9 @@ public:
         if (index < 0 || index >= length) {
             throw std::out_of_range("IndexOutOfRange");
         }
-        ShrdPtr<Node<T>> current = head;
+        Node<T>* current = head.Get();
         for (int i = 0; i < index; ++i) {
-            current = current->next;
+            current = current->next.Get();
         }
         return current->data;
     }
@@ -86,13 +115,13 @@ public:
         if (startIndex < 0 || startIndex >= length || endIndex < 0 || endIndex >= length) {
             throw std::out_of_range("IndexOutOfRange");
         }
-        ShrdPtr<LinkedList<T>> sublist(new LinkedList<T>());
-        ShrdPtr<Node<T>> current = head;
+        auto sublist = MakeShrd<LinkedList<T>>();
+        Node<T>* current = head.Get();
         for (int i = 0; i < endIndex; ++i) {
             if (i >= startIndex) {
                 sublist->Append(current->data);
             }
-            current = current->next;
+            current = current->next.Get();
         }
         return sublist;
     }
@@ -102,13 +131,13 @@ public:
     }
 
     void Append(const T& item) {
-        ShrdPtr<Node<T>> newNode(new Node<T>(item));
+        auto newNode = createNode(item);
         if (!head) {
             head = newNode;
         } else {
-            ShrdPtr<Node<T>> current = head;
+            Node<T>* current = head.Get();
             while (current->next) {
-                current = current->next;
+                current = current->next.Get();
             }
             current->next = newNode;
         }
@@ -116,7 +145,7 @@ public:
     }
 
     void Prepend(const T& item) {
-        ShrdPtr<Node<T>> newNode(new Node<T>(item));
+        auto newNode = createNode(item);
         if (head) {
             newNode->next = head;
         }
@@ -132,11 +161,11 @@ public:
             Prepend(item);
             return;
         }
-        ShrdPtr<Node<T>> current = head;
+        Node<T>* current = head.Get();
         for (int i = 0; i < index - 1; ++i) {
-            current = current->next;
+            current = current->next.Get();
         }
-        ShrdPtr<Node<T>> newNode(new Node<T>(item));
+        auto newNode = createNode(item);
         newNode->next = current->next;
         current->next = newNode;
         length++;
@@ -145,9 +174,9 @@ public:
         if (index < 0 || index >= length) {
             throw std::out_of_range("IndexOutOfRange");
         }
-        ShrdPtr<Node<T>> current = head;
+        Node<T>* current = head.Get();
         for (int i = 0; i < index; ++i) {
-            current = current->next;
+            current = current->next.Get();
         }
         current->data = value;
     }
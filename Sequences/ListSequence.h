@@ -11,24 +11,24 @@ private:
     ShrdPtr<LinkedList<T>> list;
 
 public:
-    ListSequence() : list(new LinkedList<T>()) {}
-    ListSequence(const T* items, int count) : list(new LinkedList<T>(items, count)) {}
-    ListSequence(const ListSequence<T>& listSequence) : list(new LinkedList<T>(*listSequence.list)) {}
+    ListSequence() : list(MakeShrd<LinkedList<T>>()) {}
+    ListSequence(const T* items, int count) : list(MakeShrd<LinkedList<T>>(items, count)) {}
+    ListSequence(const ListSequence<T>& listSequence) : list(MakeShrd<LinkedList<T>>(*listSequence.list)) {}
     ListSequence(const ShrdPtr<LinkedList<T>>& otherList) : list(otherList) {}
 
     ListSequence(ShrdPtr<LinkedList<T>>&& otherList) : list(std::move(otherList)) {}
     ~ListSequence() override = default;
 
     ShrdPtr<Sequence<T>> Append(const T& item) const override {
-        ShrdPtr<LinkedList<T>> newList = ShrdPtr<LinkedList<T>>(new LinkedList<T>(*this->list));
+        ShrdPtr<LinkedList<T>> newList = MakeShrd<LinkedList<T>>(*this->list);
         newList->Append(item);
-        return ShrdPtr<Sequence<T>>(new ListSequence<T>(newList));
+        return MakeShrd<ListSequence<T>>(newList);
     }
 
     ShrdPtr<Sequence<T>> Prepend(const T& item) const override {
-        ShrdPtr<LinkedList<T>> newList =  ShrdPtr<LinkedList<T>>(new LinkedList<T>(*this->list));
+        ShrdPtr<LinkedList<T>> newList =  MakeShrd<LinkedList<T>>(*this->list);
         newList->Prepend(item);
-        return ShrdPtr<Sequence<T>>(new ListSequence<T>(std::move(newList)));
+        return MakeShrd<ListSequence<T>>(std::move(newList));
     }
 
     ShrdPtr<Sequence<T>> GetSubsequence(int startIndex, int endIndex) const override {
@@ -39,14 +39,14 @@ public:
         }
 
         ShrdPtr<LinkedList<T>> subList = list->GetSubList(startIndex, endIndex);
-        ShrdPtr<LinkedList<T>> newList = ShrdPtr<LinkedList<T>>(new LinkedList<T>(*subList));
-        return ShrdPtr<Sequence<T>>(new ListSequence<T>(std::move(newList)));
+        ShrdPtr<LinkedList<T>> newList = MakeShrd<LinkedList<T>>(*subList);
+        return MakeShrd<ListSequence<T>>(std::move(newList));
     }
 
     ShrdPtr<Sequence<T>> InsertAt(const T& item, int index) const override {
-        ShrdPtr<LinkedList<T>> newList =  ShrdPtr<LinkedList<T>>(new LinkedList<T>(*this->list));
+        ShrdPtr<LinkedList<T>> newList =  MakeShrd<LinkedList<T>>(*this->list);
         newList->InsertAt(item,index);
-        return ShrdPtr<Sequence<T>>(new ListSequence<T>(std::move(newList)));
+        return MakeShrd<ListSequence<T>>(std::move(newList));
     }
 
     T GetFirst() const override {
@@ -74,7 +74,7 @@ public:
         return list->GetLength();
     }
     ShrdPtr<Sequence<T>> Copy() const override {
-        return ShrdPtr<Sequence<T>>(new ListSequence<T>(this->list));
+        return MakeShrd<ListSequence<T>>(this->list);
     }
     void Set(int index, const T& value) override {
         list->Set(index, value);
@@ -0,0 +1,358 @@
+#ifndef MAPPEDARRAYSEQUENCE_H
+#define MAPPEDARRAYSEQUENCE_H
+
+#ifdef _WIN32
+#error "MappedArraySequence requires POSIX mmap"
+#endif
+
+#include "ArraySequence.h"
+#include "ArraySpan.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum class MappedOpenMode {
+    OpenOrCreate,
+    Create,
+    OpenExisting,
+    ReadOnly
+};
+
+// Последовательность, элементы которой хранятся прямо в отображённом в память файле.
+// Формат файла: заголовок MappedHeader, затем элементы подряд.
+// В режиме ReadOnly отображение защищено от записи: изменять элементы через ссылки нельзя.
+template <typename T>
+class MappedArraySequence : public Sequence<T> {
+    // std::pair формально не trivially copyable из-за operator=, но побайтово копируется безопасно
+    static_assert(std::is_trivially_copy_constructible<T>::value && std::is_trivially_destructible<T>::value,
+                  "MappedArraySequence requires a trivially copyable T");
+
+private:
+    struct MappedHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t elementSize;
+        uint64_t length;
+        uint8_t reserved[40];
+    };
+    static_assert(sizeof(MappedHeader) == 64, "MappedHeader must stay 64 bytes");
+
+    static constexpr char fileMagic[8] = {'L', '4', 'M', 'A', 'P', 'S', 'Q', '\0'};
+    static constexpr uint32_t fileVersion = 1;
+
+    std::string path;
+    int fd;
+    bool readOnly;
+    void* mapping;
+    size_t mappedBytes;
+    size_t capacity;
+
+    static void throwSystemError(const std::string& what) {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    MappedHeader* header() const {
+        return static_cast<MappedHeader*>(mapping);
+    }
+
+    T* items() const {
+        return reinterpret_cast<T*>(static_cast<char*>(mapping) + sizeof(MappedHeader));
+    }
+
+    void checkWritable() const {
+        if (readOnly) {
+            throw std::logic_error("MappedArraySequence is opened read-only");
+        }
+    }
+
+    void checkIndex(size_t index) const {
+        if (index >= header()->length) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+    }
+
+    void mapFile(size_t bytes) {
+        int protection = readOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* result = mmap(nullptr, bytes, protection, MAP_SHARED, fd, 0);
+        if (result == MAP_FAILED) {
+            throwSystemError("mmap " + path);
+        }
+        mapping = result;
+        mappedBytes = bytes;
+        capacity = (bytes - sizeof(MappedHeader)) / sizeof(T);
+    }
+
+    void remapFile(size_t bytes) {
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            throwSystemError("ftruncate " + path);
+        }
+#ifdef __linux__
+        void* result = mremap(mapping, mappedBytes, bytes, MREMAP_MAYMOVE);
+        if (result == MAP_FAILED) {
+            throwSystemError("mremap " + path);
+        }
+        mapping = result;
+        mappedBytes = bytes;
+        capacity = (bytes - sizeof(MappedHeader)) / sizeof(T);
+#else
+        munmap(mapping, mappedBytes);
+        mapping = nullptr;
+        mapFile(bytes);
+#endif
+    }
+
+    void grow(size_t requiredCapacity) {
+        if (requiredCapacity <= capacity) {
+            return;
+        }
+        size_t newCapacity = capacity * 2;
+        if (newCapacity < requiredCapacity) {
+            newCapacity = requiredCapacity;
+        }
+        remapFile(sizeof(MappedHeader) + newCapacity * sizeof(T));
+    }
+
+    void close() {
+        if (mapping) {
+            munmap(mapping, mappedBytes);
+            mapping = nullptr;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    // Копия с item на позиции index: элементы отображения копируются один раз прямо в новый массив
+    ShrdPtr<Sequence<T>> copyWithInserted(const T& item, size_t index) const {
+        size_t length = GetLength();
+        if (index > length) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        auto newArray = MakeIntrusive<DynamicArray<T>>();
+        newArray->Reserve(length + 1);
+        const T* source = items();
+        for (size_t i = 0; i < index; ++i) {
+            newArray->PushBack(source[i]);
+        }
+        newArray->PushBack(item);
+        for (size_t i = index; i < length; ++i) {
+            newArray->PushBack(source[i]);
+        }
+        return MakeShrd<ArraySequence<T>>(std::move(newArray));
+    }
+
+public:
+    explicit MappedArraySequence(const std::string& path, MappedOpenMode mode = MappedOpenMode::OpenOrCreate)
+        : path(path), fd(-1), readOnly(mode == MappedOpenMode::ReadOnly), mapping(nullptr), mappedBytes(0), capacity(0) {
+        int flags = O_RDWR;
+        if (mode == MappedOpenMode::ReadOnly) {
+            flags = O_RDONLY;
+        } else if (mode == MappedOpenMode::OpenOrCreate) {
+            flags |= O_CREAT;
+        } else if (mode == MappedOpenMode::Create) {
+            flags |= O_CREAT | O_TRUNC;
+        }
+        fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throwSystemError("open " + path);
+        }
+
+        try {
+            struct stat info;
+            if (fstat(fd, &info) != 0) {
+                throwSystemError("fstat " + path);
+            }
+            size_t fileSize = static_cast<size_t>(info.st_size);
+
+            if (fileSize == 0) {
+                checkWritable();
+                size_t initialBytes = sizeof(MappedHeader) + 16 * sizeof(T);
+                if (ftruncate(fd, static_cast<off_t>(initialBytes)) != 0) {
+                    throwSystemError("ftruncate " + path);
+                }
+                mapFile(initialBytes);
+                std::memset(header(), 0, sizeof(MappedHeader));
+                std::memcpy(header()->magic, fileMagic, sizeof(fileMagic));
+                header()->version = fileVersion;
+                header()->elementSize = sizeof(T);
+                header()->length = 0;
+                return;
+            }
+
+            if (fileSize < sizeof(MappedHeader)) {
+                throw std::runtime_error("File is too small to be a MappedArraySequence: " + path);
+            }
+            mapFile(fileSize);
+            if (std::memcmp(header()->magic, fileMagic, sizeof(fileMagic)) != 0 || header()->version != fileVersion) {
+                throw std::runtime_error("File is not a MappedArraySequence: " + path);
+            }
+            if (header()->elementSize != sizeof(T)) {
+                throw std::runtime_error("Element size mismatch in " + path);
+            }
+            if (header()->length > capacity) {
+                throw std::runtime_error("Truncated MappedArraySequence file: " + path);
+            }
+        } catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    MappedArraySequence(const MappedArraySequence<T>&) = delete;
+    MappedArraySequence<T>& operator=(const MappedArraySequence<T>&) = delete;
+
+    ~MappedArraySequence() override {
+        close();
+    }
+
+    void Flush() {
+        if (!readOnly && msync(mapping, mappedBytes, MS_SYNC) != 0) {
+            throwSystemError("msync " + path);
+        }
+    }
+
+    void Reserve(size_t newCapacity) {
+        checkWritable();
+        if (newCapacity > capacity) {
+            remapFile(sizeof(MappedHeader) + newCapacity * sizeof(T));
+        }
+    }
+
+    // Новые элементы заполняются нулями
+    void Resize(size_t newLength) {
+        checkWritable();
+        size_t oldLength = header()->length;
+        grow(newLength);
+        if (newLength > oldLength) {
+            std::memset(static_cast<void*>(items() + oldLength), 0, (newLength - oldLength) * sizeof(T));
+        }
+        header()->length = newLength;
+    }
+
+    void Add(const T& item) {
+        checkWritable();
+        T copy = item;
+        grow(header()->length + 1);
+        items()[header()->length] = copy;
+        ++header()->length;
+    }
+
+    void AddRange(const T* source, size_t count) {
+        checkWritable();
+        size_t oldLength = header()->length;
+        // grow может перенести отображение (mremap), поэтому источник внутри самой последовательности
+        // запоминается смещением и пересчитывается после роста
+        std::less<const T*> before;
+        bool aliased = count > 0 && !before(source, items()) && before(source, items() + oldLength);
+        size_t offset = aliased ? static_cast<size_t>(source - items()) : 0;
+        grow(oldLength + count);
+        if (aliased) {
+            source = items() + offset;
+        }
+        if (count > 0) {
+            std::memmove(static_cast<void*>(items() + oldLength), static_cast<const void*>(source), count * sizeof(T));
+        }
+        header()->length = oldLength + count;
+    }
+
+    ShrdPtr<Sequence<T>> Append(const T& item) const override {
+        return copyWithInserted(item, GetLength());
+    }
+
+    ShrdPtr<Sequence<T>> Prepend(const T& item) const override {
+        return copyWithInserted(item, 0);
+    }
+
+    ShrdPtr<Sequence<T>> InsertAt(const T& item, size_t index) const override {
+        return copyWithInserted(item, index);
+    }
+
+    ShrdPtr<Sequence<T>> GetSubsequence(size_t startIndex, size_t endIndex) const override {
+        if (startIndex >= GetLength() || endIndex >= GetLength() || startIndex > endIndex) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        return MakeShrd<ArraySequence<T>>(items() + startIndex, endIndex - startIndex + 1);
+    }
+
+    T GetFirst() const override {
+        checkIndex(0);
+        return items()[0];
+    }
+
+    T GetLast() const override {
+        checkIndex(0);
+        return items()[GetLength() - 1];
+    }
+
+    const T& Get(size_t index) const override {
+        checkIndex(index);
+        return items()[index];
+    }
+
+    T& Get(size_t index) override {
+        checkIndex(index);
+        return items()[index];
+    }
+
+    T& UncheckedGet(size_t index) { return items()[index]; }
+    const T& UncheckedGet(size_t index) const { return items()[index]; }
+
+    void Set(size_t index, const T& value) override {
+        checkWritable();
+        checkIndex(index);
+        items()[index] = value;
+    }
+
+    size_t GetLength() const override {
+        return static_cast<size_t>(header()->length);
+    }
+
+    size_t GetCapacity() const {
+        return capacity;
+    }
+
+    ShrdPtr<Sequence<T>> Copy() const override {
+        return MakeShrd<ArraySequence<T>>(items(), GetLength());
+    }
+
+    void RemoveAt(size_t index) override {
+        checkWritable();
+        checkIndex(index);
+        size_t tail = GetLength() - index - 1;
+        std::memmove(static_cast<void*>(items() + index), static_cast<const void*>(items() + index + 1), tail * sizeof(T));
+        --header()->length;
+    }
+
+    T& operator[](size_t index) override {
+        return Get(index);
+    }
+
+    const T& operator[](size_t index) const override {
+        return Get(index);
+    }
+
+    // Указатель и итераторы действительны до следующего роста файла
+    T* Data() { return items(); }
+    const T* Data() const { return items(); }
+
+    T* begin() { return items(); }
+    T* end() { return items() + GetLength(); }
+    const T* begin() const { return items(); }
+    const T* end() const { return items() + GetLength(); }
+
+    ArraySpan<T> AsSpan() { return ArraySpan<T>(items(), GetLength()); }
+    ArraySpan<const T> AsSpan() const { return ArraySpan<const T>(items(), GetLength()); }
+
+    const std::string& GetPath() const { return path; }
+};
+
+#endif //MAPPEDARRAYSEQUENCE_H
@@ -0,0 +1,212 @@
+#ifndef SEQUENCEOPERATIONS_H
+#define SEQUENCEOPERATIONS_H
+
+#include "ArraySequence.h"
+#include "ThreadPool.h"
+#include <type_traits>
+#include <utility>
+
+enum class ExecutionPolicy {
+    Sequential,
+    Parallel
+};
+
+// Групповые операции над непрерывным хранилищем ArraySequence.
+// В режиме Parallel последовательность делится на блоки, которые обрабатываются в ThreadPool::Instance().
+
+inline size_t ParallelGrain(size_t length, ThreadPool& pool = ThreadPool::Instance()) {
+    size_t parts = (pool.GetThreadCount() + 1) * 4;
+    size_t grain = length / parts;
+    return grain < 4096 ? 4096 : grain;
+}
+
+// pool — для вызывающих со своим пулом (GraphLoader); остальные операции работают в ThreadPool::Instance()
+template <typename Body>
+void RunChunked(size_t length, ExecutionPolicy policy, const Body& body, ThreadPool& pool = ThreadPool::Instance()) {
+    if (policy == ExecutionPolicy::Parallel) {
+        pool.ParallelFor(0, length, ParallelGrain(length, pool), body);
+    } else if (length > 0) {
+        body(0, length);
+    }
+}
+
+template <typename T, typename Function>
+void ForEach(ArraySequence<T>& sequence, Function function, ExecutionPolicy policy = ExecutionPolicy::Sequential) {
+    T* data = sequence.Data();
+    RunChunked(sequence.GetLength(), policy, [data, &function](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            function(data[i]);
+        }
+    });
+}
+
+template <typename T, typename Function>
+auto Map(const ArraySequence<T>& sequence, Function function, ExecutionPolicy policy = ExecutionPolicy::Sequential)
+        -> ShrdPtr<ArraySequence<std::decay_t<std::invoke_result_t<Function&, const T&>>>> {
+    using R = std::decay_t<std::invoke_result_t<Function&, const T&>>;
+    size_t length = sequence.GetLength();
+    const T* source = sequence.Data();
+
+    if constexpr (std::is_default_constructible<R>::value) {
+        if (policy == ExecutionPolicy::Parallel) {
+            auto result = MakeIntrusive<DynamicArray<R>>(length);
+            R* target = result->Data();
+            RunChunked(length, policy, [source, target, &function](size_t from, size_t to) {
+                for (size_t i = from; i < to; ++i) {
+                    target[i] = function(source[i]);
+                }
+            });
+            return MakeShrd<ArraySequence<R>>(std::move(result));
+        }
+    }
+
+    auto result = MakeIntrusive<DynamicArray<R>>();
+    result->Reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        result->PushBack(function(source[i]));
+    }
+    return MakeShrd<ArraySequence<R>>(std::move(result));
+}
+
+// Порядок элементов сохраняется: каждый блок фильтруется отдельно, затем блоки склеиваются
+template <typename T, typename Predicate>
+ShrdPtr<ArraySequence<T>> Where(const ArraySequence<T>& sequence, Predicate predicate, ExecutionPolicy policy = ExecutionPolicy::Sequential) {
+    size_t length = sequence.GetLength();
+    const T* source = sequence.Data();
+    auto result = MakeIntrusive<DynamicArray<T>>();
+
+    if (policy == ExecutionPolicy::Sequential) {
+        for (size_t i = 0; i < length; ++i) {
+            if (predicate(source[i])) {
+                result->PushBack(source[i]);
+            }
+        }
+        return MakeShrd<ArraySequence<T>>(std::move(result));
+    }
+
+    size_t grain = ParallelGrain(length);
+    size_t chunks = (length + grain - 1) / grain;
+    DynamicArray<DynamicArray<T>> parts(chunks);
+    ThreadPool::Instance().ParallelFor(0, length, grain, [source, grain, &parts, &predicate](size_t from, size_t to) {
+        DynamicArray<T>& part = parts.UncheckedGet(from / grain);
+        for (size_t i = from; i < to; ++i) {
+            if (predicate(source[i])) {
+                part.PushBack(source[i]);
+            }
+        }
+    });
+
+    size_t total = 0;
+    for (const DynamicArray<T>& part : parts) {
+        total += part.GetSize();
+    }
+    result->Reserve(total);
+    for (DynamicArray<T>& part : parts) {
+        for (T& item : part) {
+            result->PushBack(std::move(item));
+        }
+    }
+    return MakeShrd<ArraySequence<T>>(std::move(result));
+}
+
+// operation должна быть ассоциативной; init учитывается ровно один раз
+template <typename T, typename Operation>
+T Reduce(const ArraySequence<T>& sequence, T init, Operation operation, ExecutionPolicy policy = ExecutionPolicy::Sequential) {
+    size_t length = sequence.GetLength();
+    const T* source = sequence.Data();
+
+    if (policy == ExecutionPolicy::Sequential || length == 0) {
+        for (size_t i = 0; i < length; ++i) {
+            init = operation(init, source[i]);
+        }
+        return init;
+    }
+
+    size_t grain = ParallelGrain(length);
+    size_t chunks = (length + grain - 1) / grain;
+    DynamicArray<T> partials;
+    partials.Reserve(chunks);
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        partials.PushBack(source[chunk * grain]);
+    }
+    ThreadPool::Instance().ParallelFor(0, length, grain, [source, grain, &partials, &operation](size_t from, size_t to) {
+        T accumulator = source[from];
+        for (size_t i = from + 1; i < to; ++i) {
+            accumulator = operation(accumulator, source[i]);
+        }
+        partials.UncheckedGet(from / grain) = std::move(accumulator);
+    });
+
+    for (const T& partial : partials) {
+        init = operation(init, partial);
+    }
+    return init;
+}
+
+// Свёртка в аккумулятор другого типа (счётчики, гистограммы): каждый блок начинает
+// с копии identity, затем результаты блоков объединяются через combine
+template <typename T, typename Accumulator, typename Operation, typename Combine>
+Accumulator Aggregate(const ArraySequence<T>& sequence, const Accumulator& identity, Operation operation, Combine combine,
+                      ExecutionPolicy policy = ExecutionPolicy::Sequential) {
+    size_t length = sequence.GetLength();
+    const T* source = sequence.Data();
+
+    if (policy == ExecutionPolicy::Sequential || length == 0) {
+        Accumulator accumulator = identity;
+        for (size_t i = 0; i < length; ++i) {
+            accumulator = operation(std::move(accumulator), source[i]);
+        }
+        return accumulator;
+    }
+
+    size_t grain = ParallelGrain(length);
+    size_t chunks = (length + grain - 1) / grain;
+    DynamicArray<Accumulator> partials;
+    partials.Reserve(chunks);
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        partials.PushBack(identity);
+    }
+    ThreadPool::Instance().ParallelFor(0, length, grain, [source, grain, &partials, &operation](size_t from, size_t to) {
+        Accumulator& accumulator = partials.UncheckedGet(from / grain);
+        for (size_t i = from; i < to; ++i) {
+            accumulator = operation(std::move(accumulator), source[i]);
+        }
+    });
+
+    Accumulator result = std::move(partials.UncheckedGet(0));
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        result = combine(std::move(result), partials.UncheckedGet(chunk));
+    }
+    return result;
+}
+
+// Длина результата равна длине более короткой последовательности
+template <typename A, typename B>
+ShrdPtr<ArraySequence<std::pair<A, B>>> Zip(const ArraySequence<A>& first, const ArraySequence<B>& second,
+                                            ExecutionPolicy policy = ExecutionPolicy::Sequential) {
+    size_t length = first.GetLength() < second.GetLength() ? first.GetLength() : second.GetLength();
+    const A* left = first.Data();
+    const B* right = second.Data();
+
+    if constexpr (std::is_default_constructible<std::pair<A, B>>::value) {
+        if (policy == ExecutionPolicy::Parallel) {
+            auto result = MakeIntrusive<DynamicArray<std::pair<A, B>>>(length);
+            std::pair<A, B>* target = result->Data();
+            RunChunked(length, policy, [left, right, target](size_t from, size_t to) {
+                for (size_t i = from; i < to; ++i) {
+                    target[i] = std::pair<A, B>(left[i], right[i]);
+                }
+            });
+            return MakeShrd<ArraySequence<std::pair<A, B>>>(std::move(result));
+        }
+    }
+
+    auto result = MakeIntrusive<DynamicArray<std::pair<A, B>>>();
+    result->Reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        result->Emplace(left[i], right[i]);
+    }
+    return MakeShrd<ArraySequence<std::pair<A, B>>>(std::move(result));
+}
+
+#endif //SEQUENCEOPERATIONS_H
@@ -0,0 +1,363 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "DynamicArray.h"
+#include "BubbleSort.h"
+#include "HeapSort.h"
+#include "InsertionSort.h"
+#include "QuickSort.h"
+#include "SelectionSort.h"
+#include "ShellSort.h"
+#include "ParallelSort.h"
+#include "RadixSort.h"
+#include "NetworkSort.h"
+#include "TimSort.h"
+
+// Бенчмарк сортировщиков из Sorts/: каждый сортировщик × тип ключа × распределение × размер.
+// Время меряется на обычных типах и std::less (работают SIMD- и radix-пути), сравнения
+// и перемещения элементов — отдельным прогоном на обёртке Counted<T>. Результат — JSON в stdout или --output.
+//
+// lab4_sort_bench [--max-size N] [--count-limit N] [--quadratic-limit N] [--output path]
+
+namespace {
+
+std::atomic<uint64_t> comparisons{0};
+std::atomic<uint64_t> moves{0};
+
+// Ключ, который считает сравнения и перемещения. Сортировки переставляют элементы через
+// std::move/std::swap, поэтому обмен виден как три перемещения
+template <typename T>
+struct Counted {
+    T value;
+
+    Counted() = default;
+    explicit Counted(const T& value) : value(value) {}
+
+    Counted(const Counted& other) : value(other.value) {
+        moves.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Counted(Counted&& other) noexcept : value(std::move(other.value)) {
+        moves.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Counted& operator=(const Counted& other) {
+        value = other.value;
+        moves.fetch_add(1, std::memory_order_relaxed);
+        return *this;
+    }
+
+    Counted& operator=(Counted&& other) noexcept {
+        value = std::move(other.value);
+        moves.fetch_add(1, std::memory_order_relaxed);
+        return *this;
+    }
+
+    bool operator<(const Counted& other) const {
+        comparisons.fetch_add(1, std::memory_order_relaxed);
+        return value < other.value;
+    }
+};
+
+struct CountedKey {
+    template <typename V>
+    const V& operator()(const Counted<V>& item) const {
+        return item.value;
+    }
+};
+
+enum class Distribution {
+    Random,
+    Sorted,
+    Reversed,
+    FewUnique,
+    OrganPipe,
+    NearlySorted
+};
+
+const char* DistributionName(Distribution distribution) {
+    switch (distribution) {
+        case Distribution::Random: return "random";
+        case Distribution::Sorted: return "sorted";
+        case Distribution::Reversed: return "reversed";
+        case Distribution::FewUnique: return "few-unique";
+        case Distribution::OrganPipe: return "organ-pipe";
+        case Distribution::NearlySorted: return "nearly-sorted";
+    }
+    return "";
+}
+
+// Неотрицательные значения < 2^31, порядок которых задаёт распределение; ключи каждого типа строятся из них
+DynamicArray<uint32_t> GenerateValues(Distribution distribution, size_t n, uint64_t seed) {
+    std::mt19937_64 random(seed);
+    DynamicArray<uint32_t> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t position = static_cast<uint32_t>(i * (0x7fffffffull / (n + 1)));
+        uint32_t value = 0;
+        switch (distribution) {
+            case Distribution::Random: value = static_cast<uint32_t>(random() & 0x7fffffff); break;
+            case Distribution::Sorted:
+            case Distribution::NearlySorted: value = position; break;
+            case Distribution::Reversed: value = static_cast<uint32_t>((n - 1 - i) * (0x7fffffffull / (n + 1))); break;
+            case Distribution::FewUnique: value = static_cast<uint32_t>(random() % 16); break;
+            case Distribution::OrganPipe:
+                value = static_cast<uint32_t>((i < n / 2 ? i : n - 1 - i) * (0x7fffffffull / (n + 1)));
+                break;
+        }
+        values.UncheckedGet(i) = value;
+    }
+    if (distribution == Distribution::NearlySorted && n > 1) {
+        for (size_t swaps = n / 100 + 1; swaps > 0; --swaps) {
+            std::swap(values.UncheckedGet(random() % n), values.UncheckedGet(random() % n));
+        }
+    }
+    return values;
+}
+
+template <typename T>
+struct KeyTraits;
+
+template <>
+struct KeyTraits<int> {
+    static const char* Name() { return "int"; }
+    static int Make(uint32_t value) { return static_cast<int>(value) - 0x40000000; }
+};
+
+template <>
+struct KeyTraits<double> {
+    static const char* Name() { return "double"; }
+    static double Make(uint32_t value) { return (static_cast<double>(value) - 1e9) * 1e-3; }
+};
+
+template <>
+struct KeyTraits<std::pair<int, int>> {
+    static const char* Name() { return "pair"; }
+    static std::pair<int, int> Make(uint32_t value) {
+        return std::make_pair(static_cast<int>(value >> 12), static_cast<int>(value & 0xfff));
+    }
+};
+
+// Фиксированная ширина: лексикографический порядок совпадает с числовым
+template <>
+struct KeyTraits<std::string> {
+    static const char* Name() { return "string"; }
+    static std::string Make(uint32_t value) {
+        char text[16];
+        std::snprintf(text, sizeof(text), "%010u", static_cast<unsigned>(value));
+        return text;
+    }
+};
+
+struct BenchOptions {
+    size_t maxSize = 1000000;
+    size_t countLimit = 1000000;
+    size_t quadraticLimit = 10000;
+    size_t minBatchElements = 1 << 16;
+    std::FILE* output = stdout;
+};
+
+struct Measurement {
+    double nsPerElement;
+    bool counted;
+    uint64_t comparisons;
+    uint64_t moves;
+};
+
+bool firstRecord = true;
+
+void WriteRecord(const BenchOptions& options, const char* sorter, const char* type, Distribution distribution,
+                 size_t n, const Measurement& measurement) {
+    std::fprintf(options.output, "%s\n  {\"sorter\": \"%s\", \"type\": \"%s\", \"distribution\": \"%s\", \"n\": %zu, "
+                 "\"ns_per_element\": %.3f, ",
+                 firstRecord ? "" : ",", sorter, type, DistributionName(distribution), n, measurement.nsPerElement);
+    if (measurement.counted) {
+        std::fprintf(options.output, "\"comparisons\": %llu, \"moves\": %llu}",
+                     static_cast<unsigned long long>(measurement.comparisons),
+                     static_cast<unsigned long long>(measurement.moves));
+    } else {
+        std::fprintf(options.output, "\"comparisons\": null, \"moves\": null}");
+    }
+    std::fflush(options.output);
+    firstRecord = false;
+}
+
+// Маленькие массивы сортируются пачкой копий, чтобы время не тонуло в погрешности таймера;
+// из нескольких повторов берётся лучший
+template <typename Sorter, typename T>
+double TimeSorter(const DynamicArray<T>& input, bool quadratic, const BenchOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    size_t n = input.GetSize();
+    size_t copies = n >= options.minBatchElements ? 1 : (options.minBatchElements + n - 1) / n;
+    if (quadratic && copies * n * n > options.minBatchElements * 64) {
+        copies = options.minBatchElements * 64 / (n * n) + 1;
+    }
+    size_t repeats = n >= 10000000 ? 1 : 3;
+
+    DynamicArray<T> batch;
+    batch.Reserve(copies * n);
+    double best = 0;
+    for (size_t repeat = 0; repeat < repeats; ++repeat) {
+        batch.Clear();
+        for (size_t copy = 0; copy < copies; ++copy) {
+            for (const T& item : input) {
+                batch.PushBack(item);
+            }
+        }
+        Sorter sorter;
+        auto start = Clock::now();
+        for (size_t copy = 0; copy < copies; ++copy) {
+            sorter.SortRange(batch.Data() + copy * n, n, std::less<T>());
+        }
+        double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        if (!std::is_sorted(batch.Data(), batch.Data() + n)) {
+            std::cerr << "lab4_sort_bench: result is not sorted" << std::endl;
+            std::exit(1);
+        }
+        double perElement = elapsed / static_cast<double>(copies * n);
+        if (repeat == 0 || perElement < best) {
+            best = perElement;
+        }
+    }
+    return best;
+}
+
+template <typename Sorter, typename T>
+void CountSorter(const DynamicArray<T>& input, Measurement& measurement) {
+    DynamicArray<Counted<T>> data;
+    data.Reserve(input.GetSize());
+    for (const T& item : input) {
+        data.PushBack(Counted<T>(item));
+    }
+    comparisons.store(0);
+    moves.store(0);
+    Sorter sorter;
+    sorter.SortRange(data.Data(), data.GetSize(), std::less<Counted<T>>());
+    measurement.counted = true;
+    measurement.comparisons = comparisons.load();
+    measurement.moves = moves.load();
+}
+
+// Sorter<K, Comparator> — шаблон сортировщика; для Counted<T> подставляется тот же алгоритм
+template <template <typename, typename> class Sorter, typename T>
+void RunSorter(const char* name, bool quadratic, const BenchOptions& options) {
+    for (size_t n = 10; n <= options.maxSize; n *= 10) {
+        if (quadratic && n > options.quadraticLimit) {
+            break;
+        }
+        for (Distribution distribution : {Distribution::Random, Distribution::Sorted, Distribution::Reversed,
+                                          Distribution::FewUnique, Distribution::OrganPipe, Distribution::NearlySorted}) {
+            DynamicArray<uint32_t> values = GenerateValues(distribution, n, 42 + n);
+            DynamicArray<T> input;
+            input.Reserve(n);
+            for (uint32_t value : values) {
+                input.PushBack(KeyTraits<T>::Make(value));
+            }
+            Measurement measurement{TimeSorter<Sorter<T, std::less<T>>>(input, quadratic, options), false, 0, 0};
+            if (n <= options.countLimit) {
+                CountSorter<Sorter<Counted<T>, std::less<Counted<T>>>>(input, measurement);
+            }
+            WriteRecord(options, name, KeyTraits<T>::Name(), distribution, n, measurement);
+        }
+    }
+}
+
+// RadixSort не сравнивает элементы: у Counted<T> ключ достаётся через CountedKey, пары меряются только по времени
+template <typename T>
+void RunRadix(const BenchOptions& options) {
+    for (size_t n = 10; n <= options.maxSize; n *= 10) {
+        for (Distribution distribution : {Distribution::Random, Distribution::Sorted, Distribution::Reversed,
+                                          Distribution::FewUnique, Distribution::OrganPipe, Distribution::NearlySorted}) {
+            DynamicArray<uint32_t> values = GenerateValues(distribution, n, 42 + n);
+            DynamicArray<T> input;
+            input.Reserve(n);
+            for (uint32_t value : values) {
+                input.PushBack(KeyTraits<T>::Make(value));
+            }
+            Measurement measurement{TimeSorter<RadixSort<T, std::less<T>>>(input, false, options), false, 0, 0};
+            if constexpr (HasRadixKey<T>::value) {
+                if (n <= options.countLimit) {
+                    CountSorter<RadixSort<Counted<T>, std::less<Counted<T>>, CountedKey>>(input, measurement);
+                }
+            }
+            WriteRecord(options, "RadixSort", KeyTraits<T>::Name(), distribution, n, measurement);
+        }
+    }
+}
+
+template <typename T>
+void RunType(const BenchOptions& options) {
+    RunSorter<BubbleSort, T>("BubbleSort", true, options);
+    RunSorter<SelectionSort, T>("SelectionSort", true, options);
+    RunSorter<InsertionSort, T>("InsertionSort", true, options);
+    RunSorter<ShellSort, T>("ShellSort", false, options);
+    RunSorter<HeapSort, T>("HeapSort", false, options);
+    RunSorter<QuickSort, T>("QuickSort", false, options);
+    RunSorter<ParallelSort, T>("ParallelSort", false, options);
+    RunSorter<NetworkSort, T>("NetworkSort", false, options);
+    RunSorter<TimSort, T>("TimSort", false, options);
+    if constexpr (!std::is_same<T, std::string>::value) {
+        RunRadix<T>(options);
+    }
+}
+
+size_t ParseSize(const char* text) {
+    char* end = nullptr;
+    double value = std::strtod(text, &end);
+    if (end == text || *end != '\0' || value < 1) {
+        std::cerr << "lab4_sort_bench: invalid size " << text << std::endl;
+        std::exit(2);
+    }
+    return static_cast<size_t>(value);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "usage: lab4_sort_bench [--max-size N] [--count-limit N] [--quadratic-limit N] [--output path]"
+                      << std::endl;
+            return 2;
+        }
+        if (argument == "--max-size") {
+            options.maxSize = ParseSize(argv[++i]);
+        } else if (argument == "--count-limit") {
+            options.countLimit = ParseSize(argv[++i]);
+        } else if (argument == "--quadratic-limit") {
+            options.quadraticLimit = ParseSize(argv[++i]);
+        } else if (argument == "--output") {
+            options.output = std::fopen(argv[++i], "w");
+            if (!options.output) {
+                std::cerr << "lab4_sort_bench: cannot open " << argv[i] << ": " << std::strerror(errno) << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "lab4_sort_bench: unknown option " << argument << std::endl;
+            return 2;
+        }
+    }
+
+    std::fprintf(options.output, "[");
+    RunType<int>(options);
+    RunType<double>(options);
+    RunType<std::pair<int, int>>(options);
+    RunType<std::string>(options);
+    std::fprintf(options.output, "\n]\n");
+    if (options.output != stdout) {
+        std::fclose(options.output);
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#ifndef ARGSORT_H
+#define ARGSORT_H
+#include "QuickSort.h"
+#include "RadixSort.h"
+#include "ArraySequence.h"
+#include "DynamicArray.h"
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Косвенная сортировка: ключи извлекаются один раз в компактный массив пар (ключ, индекс),
+// сортируется он, а тяжёлые записи остаются на месте. Результат — перестановка:
+// permutation[i] — индекс элемента, который стоит i-м в отсортированном порядке.
+// Равные ключи сохраняют исходный порядок индексов.
+
+template <typename Key>
+struct ArgSortEntry {
+    Key key;
+    size_t index;
+};
+
+template <typename T, typename KeyFunction, typename Comparator>
+ShrdPtr<ArraySequence<size_t>> ArgSortRange(const T* data, size_t n, KeyFunction key, Comparator comp) {
+    using Key = std::decay_t<std::invoke_result_t<KeyFunction&, const T&>>;
+    using Entry = ArgSortEntry<Key>;
+
+    DynamicArray<Entry> entries;
+    entries.Reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        entries.PushBack(Entry{key(data[i]), i});
+    }
+
+    // Для числовых ключей и std::less/std::greater — устойчивая поразрядная сортировка
+    if constexpr (HasRadixKey<Key>::value && IsRadixComparator<Comparator>::value) {
+        RadixSortRange(entries.Data(), n, [](const Entry& entry) { return entry.key; },
+                       IsDescendingComparator<Comparator>::value);
+    } else {
+        auto byKey = [&comp](const Entry& a, const Entry& b) {
+            if (comp(a.key, b.key)) {
+                return true;
+            }
+            return !comp(b.key, a.key) && a.index < b.index;
+        };
+        IntroSort(entries.Data(), n, byKey);
+    }
+
+    auto permutation = MakeIntrusive<DynamicArray<size_t>>(n);
+    for (size_t i = 0; i < n; ++i) {
+        permutation->UncheckedGet(i) = entries.UncheckedGet(i).index;
+    }
+    return MakeShrd<ArraySequence<size_t>>(std::move(permutation));
+}
+
+template <typename T, typename KeyFunction>
+ShrdPtr<ArraySequence<size_t>> ArgSort(const ArraySequence<T>& sequence, KeyFunction key) {
+    using Key = std::decay_t<std::invoke_result_t<KeyFunction&, const T&>>;
+    return ArgSortRange(sequence.Data(), sequence.GetLength(), key, std::less<Key>());
+}
+
+template <typename T, typename KeyFunction, typename Comparator>
+ShrdPtr<ArraySequence<size_t>> ArgSort(const ArraySequence<T>& sequence, KeyFunction key, Comparator comp) {
+    return ArgSortRange(sequence.Data(), sequence.GetLength(), key, comp);
+}
+
+// Переставляет элементы на месте: после вызова data[i] — бывший data[permutation[i]].
+// Каждый цикл перестановки обходится один раз, поэтому каждый элемент перемещается O(1) раз
+template <typename T>
+void ApplyPermutationRange(T* data, const size_t* permutation, size_t n) {
+    DynamicArray<unsigned char> visited(n);
+    for (size_t i = 0; i < n; ++i) {
+        visited.UncheckedGet(i) = 0;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        size_t target = permutation[i];
+        if (target >= n || visited.UncheckedGet(target)) {
+            throw std::invalid_argument("ApplyPermutation: not a permutation");
+        }
+        visited.UncheckedGet(target) = 1;
+    }
+
+    for (size_t start = 0; start < n; ++start) {
+        if (!visited.UncheckedGet(start)) {
+            continue;
+        }
+        visited.UncheckedGet(start) = 0;
+        size_t current = start;
+        size_t next = permutation[current];
+        if (next == start) {
+            continue;
+        }
+        T held = std::move(data[start]);
+        while (next != start) {
+            data[current] = std::move(data[next]);
+            visited.UncheckedGet(next) = 0;
+            current = next;
+            next = permutation[current];
+        }
+        data[current] = std::move(held);
+    }
+}
+
+template <typename T>
+void ApplyPermutation(ArraySequence<T>& sequence, const ArraySequence<size_t>& permutation) {
+    if (permutation.GetLength() != sequence.GetLength()) {
+        throw std::invalid_argument("ApplyPermutation: length mismatch");
+    }
+    ApplyPermutationRange(sequence.Data(), permutation.Data(), sequence.GetLength());
+}
+
+#endif //ARGSORT_H
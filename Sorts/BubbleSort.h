@@ -2,20 +2,25 @@
 #define BUBBLESORT_H
 
 #include "ISorter.h"
+#include <utility>
 
 template <typename T, typename Comparator>
-class BubbleSort: public ISorter<T, Comparator> {
-public:
-    void Sort(ShrdPtr<Sequence<T>> sequence, Comparator comp) override {
-        int n = sequence->GetLength();
-        for (int i = 0; i < n-1; i++) {
-            for (int j = 0; j < n-i-1; j++){
-                if (comp(sequence->Get(j+1),sequence->Get(j))) {
-                    std::swap(sequence->Get(j), sequence->Get(j+1));
-                }
+void BubbleSortRange(T* data, size_t n, Comparator& comp) {
+    for (size_t i = 1; i < n; ++i) {
+        for (size_t j = 0; j < n - i; ++j) {
+            if (comp(data[j + 1], data[j])) {
+                std::swap(data[j], data[j + 1]);
             }
         }
     }
+}
+
+template <typename T, typename Comparator>
+class BubbleSort : public RangeSorter<BubbleSort<T, Comparator>, T, Comparator> {
+public:
+    void SortRange(T* data, size_t n, Comparator comp) {
+        BubbleSortRange(data, n, comp);
+    }
 };
 
 #endif //BUBBLESORT_H
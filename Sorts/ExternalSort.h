@@ -0,0 +1,367 @@
+#ifndef EXTERNALSORT_H
+#define EXTERNALSORT_H
+#include "ISorter.h"
+#include "ParallelSort.h"
+#include "DynamicArray.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Внешняя сортировка для данных больше оперативной памяти. Элементы копятся в буфере размером
+// с бюджет памяти; полный буфер сортируется in-memory сортировщиком и сбрасывается во временный файл
+// (серию). Merge сливает серии деревом проигравших; если серий больше, чем помещается буферов чтения,
+// они сначала сливаются группами в более длинные серии.
+template <typename T, typename Comparator = std::less<T>>
+class ExternalSort {
+    static_assert(std::is_trivially_copy_constructible<T>::value && std::is_trivially_destructible<T>::value,
+                  "ExternalSort writes elements as raw bytes and requires a trivially copyable T");
+
+private:
+    static constexpr size_t minReadBuffer = 64 * 1024;
+
+    class RunFile {
+    private:
+        std::FILE* file;
+        std::string path;
+        size_t length;
+
+    public:
+        RunFile() : file(nullptr), length(0) {}
+
+        RunFile(std::FILE* file, std::string path) : file(file), path(std::move(path)), length(0) {}
+
+        RunFile(const RunFile&) = delete;
+        RunFile& operator=(const RunFile&) = delete;
+
+        RunFile(RunFile&& other) noexcept : file(other.file), path(std::move(other.path)), length(other.length) {
+            other.file = nullptr;
+            other.length = 0;
+        }
+
+        RunFile& operator=(RunFile&& other) noexcept {
+            if (this != &other) {
+                close();
+                file = other.file;
+                path = std::move(other.path);
+                length = other.length;
+                other.file = nullptr;
+                other.length = 0;
+            }
+            return *this;
+        }
+
+        ~RunFile() {
+            close();
+        }
+
+        void close() {
+            if (file) {
+                std::fclose(file);
+                file = nullptr;
+                if (!path.empty()) {
+                    std::remove(path.c_str());
+                }
+            }
+        }
+
+        void Write(const T* items, size_t count) {
+            if (count > 0 && std::fwrite(items, sizeof(T), count, file) != count) {
+                throwIoError("write run");
+            }
+            length += count;
+        }
+
+        void Rewind() {
+            if (std::fflush(file) != 0 || std::fseek(file, 0, SEEK_SET) != 0) {
+                throwIoError("rewind run");
+            }
+        }
+
+        size_t Read(T* items, size_t count) {
+            size_t read = std::fread(items, sizeof(T), count, file);
+            if (read < count && std::ferror(file)) {
+                throwIoError("read run");
+            }
+            return read;
+        }
+
+        size_t GetLength() const { return length; }
+    };
+
+    // Последовательное чтение серии большими блоками
+    class RunReader {
+    private:
+        RunFile* run;
+        DynamicArray<T> buffer;
+        size_t position;
+        size_t count;
+
+    public:
+        RunReader(RunFile* run, size_t bufferLength) : run(run), buffer(bufferLength), position(0), count(0) {
+            count = run->Read(buffer.Data(), buffer.GetSize());
+        }
+
+        bool IsExhausted() const { return position == count; }
+        const T& Current() const { return buffer.UncheckedGet(position); }
+
+        void Pop() {
+            if (position + 1 < count) {
+                ++position;
+                return;
+            }
+            count = run->Read(buffer.Data(), buffer.GetSize());
+            position = 0;
+        }
+    };
+
+    size_t memoryBudget;
+    std::string tempDirectory;
+    Comparator comp;
+    ShrdPtr<ISorter<T, Comparator>> sorter;
+    // Сортировщик серии берёт буфер размером с серию (как ParallelSort при слиянии)
+    bool sorterBuffered;
+    IntrusivePtr<DynamicArray<T>> pending;
+    ShrdPtr<ArraySequence<T>> pendingSequence;
+    DynamicArray<RunFile> runs;
+    size_t fileCounter;
+
+    static void throwIoError(const std::string& what) {
+        throw std::runtime_error("ExternalSort: " + what + ": " + std::strerror(errno));
+    }
+
+    // Серия вместе с буфером сортировщика укладывается в memoryBudget
+    size_t runCapacity() const {
+        size_t capacity = memoryBudget / sizeof(T) / (sorterBuffered ? 2 : 1);
+        return capacity > 0 ? capacity : 1;
+    }
+
+    void resetPending() {
+        pending = MakeIntrusive<DynamicArray<T>>();
+        pendingSequence = MakeShrd<ArraySequence<T>>(pending);
+    }
+
+    RunFile createRun() {
+        if (tempDirectory.empty()) {
+            std::FILE* file = std::tmpfile();
+            if (!file) {
+                throwIoError("tmpfile");
+            }
+            return RunFile(file, std::string());
+        }
+        std::string path = tempDirectory + "/lab4-sort-" +
+                           std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "-" +
+                           std::to_string(fileCounter++) + ".run";
+        std::FILE* file = std::fopen(path.c_str(), "w+b");
+        if (!file) {
+            throwIoError("open " + path);
+        }
+        return RunFile(file, path);
+    }
+
+    void spill() {
+        if (pending->GetSize() == 0) {
+            return;
+        }
+        sorter->Sort(pendingSequence, comp);
+        RunFile run = createRun();
+        run.Write(pending->Data(), pending->GetSize());
+        runs.PushBack(std::move(run));
+        pending->Clear();
+    }
+
+    // Равные элементы берутся из более ранней серии, поэтому слияние устойчиво между сериями
+    bool readerLess(DynamicArray<RunReader>& readers, size_t a, size_t b) const {
+        if (readers.UncheckedGet(a).IsExhausted()) {
+            return false;
+        }
+        if (readers.UncheckedGet(b).IsExhausted()) {
+            return true;
+        }
+        const T& left = readers.UncheckedGet(a).Current();
+        const T& right = readers.UncheckedGet(b).Current();
+        if (comp(left, right)) {
+            return true;
+        }
+        return !comp(right, left) && a < b;
+    }
+
+    // K-путевое слияние деревом проигравших: tree[0] — победитель, во внутренних узлах — проигравшие
+    template <typename Output>
+    void mergeRuns(RunFile* first, size_t k, Output& output) {
+        size_t bufferLength = memoryBudget / (k + 1) / sizeof(T);
+        if (bufferLength * sizeof(T) < minReadBuffer) {
+            bufferLength = minReadBuffer / sizeof(T) + 1;
+        }
+        DynamicArray<RunReader> readers;
+        readers.Reserve(k);
+        for (size_t i = 0; i < k; ++i) {
+            first[i].Rewind();
+            readers.Emplace(first + i, bufferLength);
+        }
+
+        DynamicArray<size_t> tree(k);
+        tree.UncheckedGet(0) = 0;
+        if (k > 1) {
+            DynamicArray<size_t> winners(2 * k);
+            for (size_t i = 0; i < k; ++i) {
+                winners.UncheckedGet(k + i) = i;
+            }
+            for (size_t node = k - 1; node >= 1; --node) {
+                size_t a = winners.UncheckedGet(2 * node);
+                size_t b = winners.UncheckedGet(2 * node + 1);
+                bool aWins = readerLess(readers, a, b);
+                winners.UncheckedGet(node) = aWins ? a : b;
+                tree.UncheckedGet(node) = aWins ? b : a;
+            }
+            tree.UncheckedGet(0) = winners.UncheckedGet(1);
+        }
+
+        while (true) {
+            size_t winner = tree.UncheckedGet(0);
+            RunReader& reader = readers.UncheckedGet(winner);
+            if (reader.IsExhausted()) {
+                break;
+            }
+            output(reader.Current());
+            reader.Pop();
+            for (size_t node = (winner + k) / 2; node >= 1; node /= 2) {
+                if (readerLess(readers, tree.UncheckedGet(node), winner)) {
+                    std::swap(tree.UncheckedGet(node), winner);
+                }
+            }
+            tree.UncheckedGet(0) = winner;
+        }
+    }
+
+    // Сколько серий можно сливать за раз, чтобы у каждой был буфер не меньше minReadBuffer
+    size_t maxFanIn() const {
+        size_t fanIn = memoryBudget / minReadBuffer;
+        return fanIn > 2 ? fanIn - 1 : 2;
+    }
+
+    void reduceRuns() {
+        size_t fanIn = maxFanIn();
+        while (runs.GetSize() > fanIn) {
+            DynamicArray<RunFile> merged;
+            for (size_t start = 0; start < runs.GetSize(); start += fanIn) {
+                size_t count = runs.GetSize() - start < fanIn ? runs.GetSize() - start : fanIn;
+                if (count == 1) {
+                    merged.PushBack(std::move(runs.UncheckedGet(start)));
+                    continue;
+                }
+                RunFile target = createRun();
+                DynamicArray<T> block;
+                block.Reserve(minReadBuffer / sizeof(T) + 1);
+                auto write = [&target, &block](const T& item) {
+                    block.PushBack(item);
+                    if (block.GetSize() == block.GetCapacity()) {
+                        target.Write(block.Data(), block.GetSize());
+                        block.Clear();
+                    }
+                };
+                mergeRuns(runs.Data() + start, count, write);
+                target.Write(block.Data(), block.GetSize());
+                merged.PushBack(std::move(target));
+            }
+            runs = std::move(merged);
+        }
+    }
+
+public:
+    // memoryBudget — байты под буфер серии (вместе с буфером сортировщика) и буферы слияния;
+    // tempDirectory пустая — системный каталог (tmpfile)
+    explicit ExternalSort(size_t memoryBudget = size_t(256) << 20, std::string tempDirectory = std::string(),
+                          Comparator comp = Comparator())
+        : memoryBudget(memoryBudget), tempDirectory(std::move(tempDirectory)), comp(comp),
+          sorter(MakeShrd<ParallelSort<T, Comparator>>()), sorterBuffered(true), pending(MakeIntrusive<DynamicArray<T>>()),
+          pendingSequence(MakeShrd<ArraySequence<T>>(pending)), fileCounter(0) {}
+
+    ExternalSort(const ExternalSort&) = delete;
+    ExternalSort& operator=(const ExternalSort&) = delete;
+
+    // usesBuffer = false для сортировщиков на месте (HeapSort, QuickSort): серия получает весь бюджет.
+    // Накопленные элементы сбрасываются в серию прежним сортировщиком, буфер серии выделяется заново
+    void SetSorter(ShrdPtr<ISorter<T, Comparator>> runSorter, bool usesBuffer = true) {
+        spill();
+        resetPending();
+        sorter = std::move(runSorter);
+        sorterBuffered = usesBuffer;
+    }
+
+    void Add(const T& item) {
+        // Буфер серии выделяется один раз: удвоение PushBack вышло бы за бюджет
+        if (pending->GetCapacity() == 0) {
+            pending->Reserve(runCapacity());
+        }
+        pending->PushBack(item);
+        if (pending->GetSize() >= runCapacity()) {
+            spill();
+        }
+    }
+
+    void AddRange(const T* items, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            Add(items[i]);
+        }
+    }
+
+    size_t GetRunCount() const {
+        return runs.GetSize();
+    }
+
+    // Передаёт все элементы в output(const T&) в отсортированном порядке и очищает сортировщик
+    template <typename Output>
+    void Merge(Output output) {
+        if (runs.GetSize() == 0) {
+            sorter->Sort(pendingSequence, comp);
+            for (const T& item : *pending) {
+                output(item);
+            }
+            pending->Clear();
+            return;
+        }
+        spill();
+        resetPending();
+        reduceRuns();
+        mergeRuns(runs.Data(), runs.GetSize(), output);
+        runs = DynamicArray<RunFile>();
+    }
+
+    // Записывает результат в файл как массив элементов без заголовка
+    void MergeToFile(const std::string& path) {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            throwIoError("open " + path);
+        }
+        DynamicArray<T> block;
+        block.Reserve(minReadBuffer / sizeof(T) + 1);
+        try {
+            Merge([file, &block](const T& item) {
+                block.PushBack(item);
+                if (block.GetSize() == block.GetCapacity()) {
+                    if (std::fwrite(block.Data(), sizeof(T), block.GetSize(), file) != block.GetSize()) {
+                        throwIoError("write output");
+                    }
+                    block.Clear();
+                }
+            });
+            if (std::fwrite(block.Data(), sizeof(T), block.GetSize(), file) != block.GetSize()) {
+                throwIoError("write output");
+            }
+        } catch (...) {
+            std::fclose(file);
+            throw;
+        }
+        if (std::fclose(file) != 0) {
+            throwIoError("close " + path);
+        }
+    }
+};
+
+#endif //EXTERNALSORT_H
@@ -1,35 +1,45 @@
 #ifndef HEAPSORT_H
 #define HEAPSORT_H
 #include "ISorter.h"
+#include <utility>
+
+// Просеивание вниз без рекурсии: элемент i опускается, пока меньше большего из потомков
 template <typename T, typename Comparator>
-class HeapSort : public ISorter<T, Comparator> {
-public:
-    void Sort(ShrdPtr<Sequence<T>> sequence, Comparator comp) override {
-        size_t n = sequence->GetLength();
-        for (int i = n / 2 - 1; i >= 0; --i) {
-            heapify(sequence, n, i, comp);
+void SiftDown(T* data, size_t n, size_t i, Comparator& comp) {
+    T value = std::move(data[i]);
+    while (2 * i + 1 < n) {
+        size_t child = 2 * i + 1;
+        if (child + 1 < n && comp(data[child], data[child + 1])) {
+            ++child;
         }
-        for (int i = n - 1; i > 0; --i) {
-            std::swap(sequence->Get(0), sequence->Get(i));
-            heapify(sequence, i, 0, comp);
+        if (!comp(value, data[child])) {
+            break;
         }
+        data[i] = std::move(data[child]);
+        i = child;
     }
+    data[i] = std::move(value);
+}
 
-private:
-    void heapify(ShrdPtr<Sequence<T>> sequence, size_t n, size_t i, Comparator comp) {
-        size_t largest = i;
-        size_t l = 2 * i + 1;
-        size_t r = 2 * i + 2;
-        if (l < n && comp(sequence->Get(largest), sequence->Get(l))) {
-            largest = l;
-        }
-        if (r < n && comp(sequence->Get(largest), sequence->Get(r))) {
-            largest = r;
-        }
-        if (largest != i) {
-            std::swap(sequence->Get(i), sequence->Get(largest));
-            heapify(sequence, n, largest, comp);
-        }
+template <typename T, typename Comparator>
+void HeapSortRange(T* data, size_t n, Comparator& comp) {
+    if (n < 2) {
+        return;
+    }
+    for (size_t i = n / 2; i > 0; --i) {
+        SiftDown(data, n, i - 1, comp);
+    }
+    for (size_t i = n - 1; i > 0; --i) {
+        std::swap(data[0], data[i]);
+        SiftDown(data, i, 0, comp);
+    }
+}
+
+template <typename T, typename Comparator>
+class HeapSort : public RangeSorter<HeapSort<T, Comparator>, T, Comparator> {
+public:
+    void SortRange(T* data, size_t n, Comparator comp) {
+        HeapSortRange(data, n, comp);
     }
 };
 #endif //HEAPSORT_H
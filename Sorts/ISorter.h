@@ -1,9 +1,16 @@
 #ifndef ISORTER_H
 #define ISORTER_H
 
-#include "Sequence.h"
+#include "ArraySequence.h"
+#include "DynamicArray.h"
 #include "ShrdPtr.h"
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+// Интерфейс с удалённым типом: сортировщик можно выбрать во время выполнения (ExternalSort, тесты)
 template <typename T, typename Comparator>
 class ISorter {
 public:
@@ -11,4 +18,52 @@ public:
     virtual ~ISorter() = default;
 };
 
+// Итераторы, чьи элементы заведомо лежат подряд: указатели (в том числе итераторы ArraySequence) и
+// итераторы std::vector, кроме упакованного std::vector<bool>
+template <typename Iterator, typename = void>
+struct IsContiguousIterator : std::is_pointer<Iterator> {};
+
+template <typename Iterator>
+struct IsContiguousIterator<Iterator, std::enable_if_t<!std::is_pointer<Iterator>::value>>
+    : std::bool_constant<
+          !std::is_same<typename std::iterator_traits<Iterator>::value_type, bool>::value &&
+          (std::is_same<Iterator, typename std::vector<typename std::iterator_traits<Iterator>::value_type>::iterator>::value ||
+           std::is_same<Iterator, typename std::vector<typename std::iterator_traits<Iterator>::value_type>::const_iterator>::value)> {};
+
+// Основа сортировщиков: Derived::SortRange(T*, size_t, Comparator) работает с непрерывным диапазоном,
+// обращения к элементам и вызовы comp встраиваются. Sort для ISorter — тонкая обёртка над SortRange
+template <typename Derived, typename T, typename Comparator>
+class RangeSorter : public ISorter<T, Comparator> {
+public:
+    void Sort(ShrdPtr<ArraySequence<T>> sequence, Comparator comp) override {
+        static_cast<Derived*>(this)->SortRange(sequence->Data(), sequence->GetLength(), comp);
+    }
+
+    // Непрерывный диапазон сортируется на месте; остальные итераторы произвольного доступа (например,
+    // DequeSequence) — через перенос во временный буфер и обратно
+    template <typename Iterator>
+    void Sort(Iterator first, Iterator last, Comparator comp) {
+        static_assert(std::is_base_of<std::random_access_iterator_tag,
+                                      typename std::iterator_traits<Iterator>::iterator_category>::value,
+                      "RangeSorter::Sort requires random access iterators");
+        if (first == last) {
+            return;
+        }
+        size_t n = static_cast<size_t>(last - first);
+        if constexpr (IsContiguousIterator<Iterator>::value) {
+            static_cast<Derived*>(this)->SortRange(std::addressof(*first), n, comp);
+        } else {
+            DynamicArray<T> buffer;
+            buffer.Reserve(n);
+            for (Iterator it = first; it != last; ++it) {
+                buffer.PushBack(std::move(*it));
+            }
+            static_cast<Derived*>(this)->SortRange(buffer.Data(), n, comp);
+            for (size_t i = 0; i < n; ++i, ++first) {
+                *first = std::move(buffer.UncheckedGet(i));
+            }
+        }
+    }
+};
+
 #endif //ISORTER_H
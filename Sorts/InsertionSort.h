@@ -1,21 +1,29 @@
 #ifndef INSERTIONSORT_H
 #define INSERTIONSORT_H
 #include "ISorter.h"
+#include <utility>
 
 template <typename T, typename Comparator>
-class InsertionSort : public ISorter<T, Comparator> {
-public:
-    void Sort(ShrdPtr<Sequence<T>> sequence, Comparator comp) override {
-        size_t n = sequence->GetLength();
-        for (size_t i = 1; i < n; ++i) {
-            T key = sequence->Get(i);
-            int j = i - 1;
-            while (j >= 0 && comp(key, sequence->Get(j))) {
-                sequence->Set(j + 1, sequence->Get(j));
-                --j;
-            }
-            sequence->Set(j + 1, key);
+void InsertionSortRange(T* data, size_t n, Comparator& comp) {
+    for (size_t i = 1; i < n; ++i) {
+        if (!comp(data[i], data[i - 1])) {
+            continue;
         }
+        T key = std::move(data[i]);
+        size_t j = i;
+        do {
+            data[j] = std::move(data[j - 1]);
+            --j;
+        } while (j > 0 && comp(key, data[j - 1]));
+        data[j] = std::move(key);
+    }
+}
+
+template <typename T, typename Comparator>
+class InsertionSort : public RangeSorter<InsertionSort<T, Comparator>, T, Comparator> {
+public:
+    void SortRange(T* data, size_t n, Comparator comp) {
+        InsertionSortRange(data, n, comp);
     }
 };
 #endif //INSERTIONSORT_H
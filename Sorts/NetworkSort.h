@@ -0,0 +1,41 @@
+#ifndef NETWORKSORT_H
+#define NETWORKSORT_H
+#include "ISorter.h"
+#include "SortingNetworks.h"
+#include "ParallelSort.h"
+#include "DynamicArray.h"
+#include <utility>
+
+// Блоки по NetworkBlockSize элементов сортируются сортирующей сетью, затем сливаются снизу вверх
+template <typename T, typename Comparator>
+void NetworkSortRange(T* data, size_t n, Comparator comp) {
+    for (size_t from = 0; from < n; from += NetworkBlockSize) {
+        NetworkSortBlock(data + from, n - from < NetworkBlockSize ? n - from : NetworkBlockSize, comp);
+    }
+    if (n <= NetworkBlockSize) {
+        return;
+    }
+
+    DynamicArray<T> buffer(n);
+    T* source = data;
+    T* target = buffer.Data();
+    for (size_t width = NetworkBlockSize; width < n; width *= 2) {
+        MergePassSlice(source, target, n, width, 0, n, 0, 0, comp);
+        std::swap(source, target);
+    }
+    if (source != data) {
+        for (size_t i = 0; i < n; ++i) {
+            data[i] = std::move(source[i]);
+        }
+    }
+}
+
+template <typename T, typename Comparator>
+class NetworkSort : public RangeSorter<NetworkSort<T, Comparator>, T, Comparator> {
+public:
+    void SortRange(T* data, size_t n, Comparator comp) {
+        NetworkSortRange(data, n, comp);
+    }
+};
+
+#endif //NETWORKSORT_H
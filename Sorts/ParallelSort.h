@@ -0,0 +1,135 @@
+#ifndef PARALLELSORT_H
+#define PARALLELSORT_H
+#include "ISorter.h"
+#include "QuickSort.h"
+#include "ThreadPool.h"
+#include "DynamicArray.h"
+#include <utility>
+
+// Параллельная сортировка слиянием: массив делится на блоки по числу потоков, блоки
+// сортируются IntroSort, затем сливаются попарно. Каждый проход слияния делится по позициям
+// результата (co-rank), поэтому все потоки заняты даже на последнем слиянии двух половин.
+// Сортировка неустойчива: блоки сортируются IntroSort.
+
+constexpr size_t ParallelSortThreshold = 1 << 15;
+
+// Сколько элементов первой части попадает в первые k элементов слияния (равные — сначала из first)
+template <typename T, typename Comparator>
+size_t MergeCoRank(size_t k, const T* first, size_t firstLength, const T* second, size_t secondLength, Comparator& comp) {
+    size_t low = k > secondLength ? k - secondLength : 0;
+    size_t high = k < firstLength ? k : firstLength;
+    while (low < high) {
+        size_t i = low + (high - low) / 2;
+        size_t j = k - i;
+        if (j > 0 && i < firstLength && !comp(second[j - 1], first[i])) {
+            low = i + 1;
+        } else {
+            high = i;
+        }
+    }
+    return low;
+}
+
+template <typename T, typename Comparator>
+void MergeMove(T* first, T* firstEnd, T* second, T* secondEnd, T* target, Comparator& comp) {
+    while (first != firstEnd && second != secondEnd) {
+        if (comp(*second, *first)) {
+            *target++ = std::move(*second++);
+        } else {
+            *target++ = std::move(*first++);
+        }
+    }
+    while (first != firstEnd) {
+        *target++ = std::move(*first++);
+    }
+    while (second != secondEnd) {
+        *target++ = std::move(*second++);
+    }
+}
+
+// Co-rank позиции position результата прохода слияния внутри её пары отрезков длины width
+template <typename T, typename Comparator>
+size_t MergePassRank(const T* source, size_t n, size_t width, size_t position, Comparator& comp) {
+    size_t pairStart = position / (2 * width) * (2 * width);
+    size_t middle = pairStart + width < n ? pairStart + width : n;
+    size_t pairEnd = middle + width < n ? middle + width : n;
+    return MergeCoRank(position - pairStart, source + pairStart, middle - pairStart, source + middle, pairEnd - middle, comp);
+}
+
+// Сливает соседние отрезки длины width из source в target для части [from, to) результата.
+// fromRank и toRank считаются заранее: во время слияния другие потоки уже переносят элементы source
+template <typename T, typename Comparator>
+void MergePassSlice(T* source, T* target, size_t n, size_t width, size_t from, size_t to,
+                    size_t fromRank, size_t toRank, Comparator& comp) {
+    size_t pairStart = from / (2 * width) * (2 * width);
+    for (; pairStart < to; pairStart += 2 * width) {
+        size_t middle = pairStart + width < n ? pairStart + width : n;
+        size_t pairEnd = middle + width < n ? middle + width : n;
+        size_t outFrom = from > pairStart ? from - pairStart : 0;
+        size_t outTo = (to < pairEnd ? to : pairEnd) - pairStart;
+
+        T* first = source + pairStart;
+        T* second = source + middle;
+        size_t i = outFrom > 0 ? fromRank : 0;
+        size_t iEnd = to < pairEnd ? toRank : middle - pairStart;
+        MergeMove(first + i, first + iEnd, second + (outFrom - i), second + (outTo - iEnd),
+                  target + pairStart + outFrom, comp);
+    }
+}
+
+template <typename T, typename Comparator>
+void ParallelSortRange(T* data, size_t n, Comparator comp, ThreadPool& pool = ThreadPool::Instance()) {
+    size_t threads = pool.GetThreadCount() + 1;
+    if (n < ParallelSortThreshold || threads == 1) {
+        IntroSort(data, n, comp);
+        return;
+    }
+
+    size_t width = (n + threads - 1) / threads;
+    pool.ParallelFor(0, n, width, [data, n, &comp](size_t from, size_t to) {
+        Comparator local = comp;
+        IntroSort(data + from, to - from, local);
+    });
+
+    DynamicArray<T> buffer(n);
+    T* source = data;
+    T* target = buffer.Data();
+    size_t grain = n / (threads * 4) + 1;
+    size_t slices = (n + grain - 1) / grain;
+    DynamicArray<size_t> ranks(slices + 1);
+    for (; width < n; width *= 2) {
+        for (size_t slice = 0; slice <= slices; ++slice) {
+            size_t position = slice * grain < n ? slice * grain : n;
+            ranks.UncheckedGet(slice) = MergePassRank(source, n, width, position, comp);
+        }
+        pool.ParallelFor(0, n, grain, [source, target, n, width, grain, &ranks, &comp](size_t from, size_t to) {
+            Comparator local = comp;
+            size_t slice = from / grain;
+            MergePassSlice(source, target, n, width, from, to, ranks.UncheckedGet(slice), ranks.UncheckedGet(slice + 1), local);
+        });
+        std::swap(source, target);
+    }
+
+    if (source != data) {
+        pool.ParallelFor(0, n, grain, [source, data](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) {
+                data[i] = std::move(source[i]);
+            }
+        });
+    }
+}
+
+template <typename T, typename Comparator>
+class ParallelSort : public RangeSorter<ParallelSort<T, Comparator>, T, Comparator> {
+private:
+    ThreadPool& pool;
+
+public:
+    explicit ParallelSort(ThreadPool& pool = ThreadPool::Instance()) : pool(pool) {}
+
+    void SortRange(T* data, size_t n, Comparator comp) {
+        ParallelSortRange(data, n, comp, pool);
+    }
+};
+
+#endif //PARALLELSORT_H
@@ -0,0 +1,137 @@
+#ifndef PARTIALSORT_H
+#define PARTIALSORT_H
+#include "QuickSort.h"
+#include "HeapSort.h"
+#include "InsertionSort.h"
+#include "ArraySequence.h"
+#include "DynamicArray.h"
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+// Выбор k-го элемента без полной сортировки: NthElement — интроселект за O(n) в среднем
+// (при вырождении разбиений — HeapSort остатка), PartialSort — O(n + k log k),
+// TopK — k лучших элементов потока за O(n log k) и O(k) памяти.
+
+// После вызова data[k] стоит на своём месте в отсортированном порядке,
+// слева от него элементы не больше, справа — не меньше
+template <typename T, typename Comparator>
+void NthElementRange(T* data, size_t n, size_t k, Comparator& comp) {
+    size_t depthLimit = IntroSortDepthLimit(n);
+    while (n > IntroSortCutoff) {
+        if (depthLimit == 0) {
+            HeapSortRange(data, n, comp);
+            return;
+        }
+        --depthLimit;
+        std::pair<size_t, size_t> bounds = PartitionThreeWay(data, n, ChoosePivot(data, n, comp), comp);
+        if (k < bounds.first) {
+            n = bounds.first;
+        } else if (k >= bounds.second) {
+            data += bounds.second;
+            n -= bounds.second;
+            k -= bounds.second;
+        } else {
+            return;
+        }
+    }
+    InsertionSortRange(data, n, comp);
+}
+
+// Первые k элементов отсортированы и меньше остальных; порядок остальных не определён
+template <typename T, typename Comparator>
+void PartialSortRange(T* data, size_t n, size_t k, Comparator& comp) {
+    if (k == 0) {
+        return;
+    }
+    if (k < n) {
+        NthElementRange(data, n, k - 1, comp);
+    }
+    IntroSort(data, k < n ? k : n, comp);
+}
+
+template <typename T, typename Comparator = std::less<T>>
+void PartialSort(ArraySequence<T>& sequence, size_t k, Comparator comp = Comparator()) {
+    if (k > sequence.GetLength()) {
+        throw std::out_of_range("IndexOutOfRange");
+    }
+    PartialSortRange(sequence.Data(), sequence.GetLength(), k, comp);
+}
+
+template <typename T, typename Comparator = std::less<T>>
+const T& NthElement(ArraySequence<T>& sequence, size_t k, Comparator comp = Comparator()) {
+    if (k >= sequence.GetLength()) {
+        throw std::out_of_range("IndexOutOfRange");
+    }
+    NthElementRange(sequence.Data(), sequence.GetLength(), k, comp);
+    return sequence.UncheckedGet(k);
+}
+
+// Накопитель k наименьших (по comp) элементов потока. Хранит max-кучу из k элементов:
+// в вершине худший из отобранных, новый элемент вытесняет его, только если он лучше
+template <typename T, typename Comparator = std::less<T>>
+class TopK {
+private:
+    DynamicArray<T> heap;
+    size_t k;
+    Comparator comp;
+
+    void siftUp(size_t i) {
+        T value = std::move(heap.UncheckedGet(i));
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!comp(heap.UncheckedGet(parent), value)) {
+                break;
+            }
+            heap.UncheckedGet(i) = std::move(heap.UncheckedGet(parent));
+            i = parent;
+        }
+        heap.UncheckedGet(i) = std::move(value);
+    }
+
+public:
+    explicit TopK(size_t k, Comparator comp = Comparator()) : k(k), comp(comp) {
+        heap.Reserve(k);
+    }
+
+    template <typename U>
+    void Push(U&& item) {
+        if (heap.GetSize() < k) {
+            heap.PushBack(std::forward<U>(item));
+            siftUp(heap.GetSize() - 1);
+        } else if (k > 0 && comp(item, heap.UncheckedGet(0))) {
+            heap.UncheckedGet(0) = std::forward<U>(item);
+            SiftDown(heap.Data(), heap.GetSize(), 0, comp);
+        }
+    }
+
+    size_t GetLength() const {
+        return heap.GetSize();
+    }
+
+    size_t GetK() const {
+        return k;
+    }
+
+    // Худший из отобранных: элементы не лучше него в результат уже не попадут
+    const T& GetThreshold() const {
+        if (heap.GetSize() == 0) {
+            throw std::out_of_range("IndexOutOfRange");
+        }
+        return heap.UncheckedGet(0);
+    }
+
+    // Отобранные элементы по возрастанию; накопитель остаётся пригодным для новых Push
+    ShrdPtr<ArraySequence<T>> GetSorted() const {
+        auto result = MakeShrd<ArraySequence<T>>(heap.Data(), heap.GetSize());
+        Comparator order = comp;
+        HeapSortRange(result->Data(), result->GetLength(), order);
+        return result;
+    }
+
+    void Clear() {
+        heap.Clear();
+    }
+};
+
+#endif //PARTIALSORT_H
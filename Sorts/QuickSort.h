@@ -1,40 +1,112 @@
 #ifndef QUICKSORT_H
 #define QUICKSORT_H
 #include "ISorter.h"
-#include <iostream>
+#include "HeapSort.h"
+#include "InsertionSort.h"
+#include "SortingNetworks.h"
+#include <utility>
+
+// Интроспективная сортировка: быстрая сортировка с опорным элементом — медианой трёх
+// (для больших блоков — медианой медиан девяти), трёхсторонним разбиением для повторов,
+// сортировкой вставками на коротких блоках и HeapSort, если глубина превысила 2·log n.
+
+constexpr size_t IntroSortCutoff = 16;
+constexpr size_t NintherThreshold = 128;
+
 template <typename T, typename Comparator>
-class QuickSort : public ISorter<T, Comparator> {
-public:
-    void Sort(ShrdPtr<ArraySequence<T>> sequence, Comparator comp) {
-        size_t n = sequence->GetLength();
-        if (n > 0) {
-            quickSort(sequence, 0, n - 1, comp);
+size_t MedianOfThree(const T* data, size_t a, size_t b, size_t c, Comparator& comp) {
+    if (comp(data[a], data[b])) {
+        if (comp(data[b], data[c])) {
+            return b;
         }
+        return comp(data[a], data[c]) ? c : a;
+    }
+    if (comp(data[a], data[c])) {
+        return a;
     }
+    return comp(data[b], data[c]) ? c : b;
+}
 
-private:
-    size_t partition(ShrdPtr<ArraySequence<T>> sequence, size_t low, size_t high, Comparator comp) {
-        T pivot = sequence->Get(high);
-        size_t i = (low - 1);
+template <typename T, typename Comparator>
+size_t ChoosePivot(const T* data, size_t n, Comparator& comp) {
+    size_t middle = n / 2;
+    if (n < NintherThreshold) {
+        return MedianOfThree(data, 0, middle, n - 1, comp);
+    }
+    size_t step = n / 8;
+    size_t first = MedianOfThree(data, 0, step, 2 * step, comp);
+    size_t second = MedianOfThree(data, middle - step, middle, middle + step, comp);
+    size_t third = MedianOfThree(data, n - 1 - 2 * step, n - 1 - step, n - 1, comp);
+    return MedianOfThree(data, first, second, third, comp);
+}
 
-        for (size_t j = low; j <= high - 1; j++) {
-            if (comp(sequence->Get(j), pivot)) {
-                i++;
-                std::swap(sequence->Get(i), sequence->Get(j));
-            }
+// Разбиение Дейкстры: [0, less) < pivot, [less, greater) == pivot, [greater, n) > pivot
+template <typename T, typename Comparator>
+std::pair<size_t, size_t> PartitionThreeWay(T* data, size_t n, size_t pivotIndex, Comparator& comp) {
+    std::swap(data[0], data[pivotIndex]);
+    size_t less = 0;
+    size_t i = 1;
+    size_t greater = n;
+    while (i < greater) {
+        if (comp(data[i], data[less])) {
+            std::swap(data[less++], data[i++]);
+        } else if (comp(data[less], data[i])) {
+            std::swap(data[i], data[--greater]);
+        } else {
+            ++i;
         }
-        std::swap(sequence->Get(i + 1), sequence->Get(high));
-        return (i + 1);
     }
+    return {less, greater};
+}
 
-    void quickSort(ShrdPtr<ArraySequence<T>> sequence, size_t low, size_t high, Comparator comp) {
-        if (low < high) {
-            size_t pi = partition(sequence, low, high, comp);
+inline size_t IntroSortDepthLimit(size_t n) {
+    size_t depth = 0;
+    for (; n > 1; n >>= 1) {
+        ++depth;
+    }
+    return 2 * depth;
+}
 
-            quickSort(sequence, low, pi - 1, comp);
-            quickSort(sequence, pi + 1, high, comp);
+// Рекурсия идёт только в меньшую часть, поэтому глубина стека O(log n)
+template <typename T, typename Comparator>
+void IntroSortLoop(T* data, size_t n, size_t depthLimit, Comparator& comp) {
+    constexpr size_t cutoff = HasSimdNetwork<T, Comparator>::value ? NetworkBlockSize : IntroSortCutoff;
+    while (n > cutoff) {
+        if (depthLimit == 0) {
+            HeapSortRange(data, n, comp);
+            return;
+        }
+        --depthLimit;
+        std::pair<size_t, size_t> bounds = PartitionThreeWay(data, n, ChoosePivot(data, n, comp), comp);
+        size_t leftSize = bounds.first;
+        size_t rightSize = n - bounds.second;
+        if (leftSize < rightSize) {
+            IntroSortLoop(data, leftSize, depthLimit, comp);
+            data += bounds.second;
+            n = rightSize;
+        } else {
+            IntroSortLoop(data + bounds.second, rightSize, depthLimit, comp);
+            n = leftSize;
         }
     }
+    if constexpr (HasSimdNetwork<T, Comparator>::value) {
+        NetworkSortBlock(data, n, comp);
+    } else {
+        InsertionSortRange(data, n, comp);
+    }
+}
+
+template <typename T, typename Comparator>
+void IntroSort(T* data, size_t n, Comparator comp) {
+    IntroSortLoop(data, n, IntroSortDepthLimit(n), comp);
+}
+
+template <typename T, typename Comparator>
+class QuickSort : public RangeSorter<QuickSort<T, Comparator>, T, Comparator> {
+public:
+    void SortRange(T* data, size_t n, Comparator comp) {
+        IntroSort(data, n, comp);
+    }
 };
 
-#endif //QUICKSORT_H
\ No newline at end of file
+#endif //QUICKSORT_H
@@ -0,0 +1,179 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+#include "ISorter.h"
+#include "InsertionSort.h"
+#include "DynamicArray.h"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Отображение ключа в беззнаковое число с тем же порядком:
+// у знаковых целых инвертируется знаковый бит, у float/double отрицательные числа инвертируются целиком
+template <typename K, typename = void>
+struct RadixKey;
+
+template <typename K>
+struct RadixKey<K, std::enable_if_t<std::is_integral<K>::value && !std::is_same<K, bool>::value>> {
+    using Unsigned = std::make_unsigned_t<K>;
+
+    static Unsigned Get(K value) {
+        if constexpr (std::is_signed<K>::value) {
+            return static_cast<Unsigned>(static_cast<Unsigned>(value) ^ (Unsigned(1) << (sizeof(K) * 8 - 1)));
+        } else {
+            return value;
+        }
+    }
+};
+
+template <typename K>
+struct RadixKey<K, std::enable_if_t<std::is_floating_point<K>::value && (sizeof(K) == 4 || sizeof(K) == 8)>> {
+    using Unsigned = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+
+    static Unsigned Get(K value) {
+        Unsigned bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const Unsigned sign = Unsigned(1) << (sizeof(K) * 8 - 1);
+        return (bits & sign) ? ~bits : bits | sign;
+    }
+};
+
+// Есть ли для типа ключа отображение RadixKey (целые и float/double)
+template <typename K, typename = void>
+struct HasRadixKey : std::false_type {};
+
+template <typename K>
+struct HasRadixKey<K, std::void_t<typename RadixKey<K>::Unsigned>> : std::true_type {};
+
+struct RadixIdentity {
+    template <typename V>
+    const V& operator()(const V& value) const {
+        return value;
+    }
+};
+
+template <typename Comparator>
+struct IsDescendingComparator : std::false_type {};
+
+template <typename V>
+struct IsDescendingComparator<std::greater<V>> : std::true_type {};
+
+template <typename Comparator>
+struct IsRadixComparator : std::false_type {};
+
+template <typename V>
+struct IsRadixComparator<std::less<V>> : std::true_type {};
+
+template <typename V>
+struct IsRadixComparator<std::greater<V>> : std::true_type {};
+
+constexpr size_t RadixInsertionThreshold = 64;
+
+// Устойчивая LSD-сортировка по ключу key(item): гистограммы всех разрядов строятся за один проход,
+// проходы, в которых у всех элементов одинаковый разряд, пропускаются.
+// Ширина разряда 8, 11 или 16 бит выбирается по длине ключа и числу элементов.
+template <typename T, typename KeyFunction>
+void RadixSortRange(T* data, size_t n, KeyFunction key, bool descending = false) {
+    using Raw = std::decay_t<std::invoke_result_t<KeyFunction&, const T&>>;
+    using Unsigned = typename RadixKey<Raw>::Unsigned;
+    constexpr size_t keyBits = sizeof(Unsigned) * 8;
+
+    auto digits = [&key, descending](const T& item) {
+        Unsigned value = RadixKey<Raw>::Get(key(item));
+        return descending ? static_cast<Unsigned>(~value) : value;
+    };
+
+    if (n < RadixInsertionThreshold) {
+        auto less = [&digits](const T& a, const T& b) { return digits(a) < digits(b); };
+        InsertionSortRange(data, n, less);
+        return;
+    }
+
+    size_t bits;
+    if (keyBits <= 16) {
+        bits = keyBits;
+    } else if (n < (size_t(1) << 12)) {
+        bits = 8;
+    } else if (keyBits == 32 || n < (size_t(1) << 22)) {
+        bits = 11;
+    } else {
+        bits = 16;
+    }
+    const size_t passes = (keyBits + bits - 1) / bits;
+    const size_t buckets = size_t(1) << bits;
+    const Unsigned mask = static_cast<Unsigned>(buckets - 1);
+
+    DynamicArray<size_t> counts(passes * buckets);
+    size_t* histogram = counts.Data();
+    for (size_t i = 0; i < n; ++i) {
+        Unsigned value = digits(data[i]);
+        for (size_t pass = 0; pass < passes; ++pass) {
+            ++histogram[pass * buckets + ((value >> (pass * bits)) & mask)];
+        }
+    }
+
+    DynamicArray<T> buffer(n);
+    T* source = data;
+    T* target = buffer.Data();
+    for (size_t pass = 0; pass < passes; ++pass) {
+        size_t* offsets = histogram + pass * buckets;
+        bool trivial = false;
+        size_t sum = 0;
+        for (size_t bucket = 0; bucket < buckets; ++bucket) {
+            size_t count = offsets[bucket];
+            if (count == n) {
+                trivial = true;
+                break;
+            }
+            offsets[bucket] = sum;
+            sum += count;
+        }
+        if (trivial) {
+            continue;
+        }
+        size_t shift = pass * bits;
+        for (size_t i = 0; i < n; ++i) {
+            size_t bucket = (digits(source[i]) >> shift) & mask;
+            target[offsets[bucket]++] = std::move(source[i]);
+        }
+        std::swap(source, target);
+    }
+
+    if (source != data) {
+        for (size_t i = 0; i < n; ++i) {
+            data[i] = std::move(source[i]);
+        }
+    }
+}
+
+// Comparator задаёт только направление: std::less — по возрастанию ключа, std::greater — по убыванию.
+// Пары без KeyExtractor сортируются лексикографически: сначала по second, затем устойчиво по first
+template <typename T, typename Comparator = std::less<T>, typename KeyExtractor = RadixIdentity>
+class RadixSort : public RangeSorter<RadixSort<T, Comparator, KeyExtractor>, T, Comparator> {
+    static_assert(IsRadixComparator<Comparator>::value, "RadixSort orders by key: use std::less or std::greater");
+
+private:
+    KeyExtractor key;
+
+    template <typename V>
+    struct IsPair : std::false_type {};
+
+    template <typename A, typename B>
+    struct IsPair<std::pair<A, B>> : std::true_type {};
+
+public:
+    explicit RadixSort(KeyExtractor key = KeyExtractor()) : key(key) {}
+
+    void SortRange(T* data, size_t n, Comparator) {
+        constexpr bool descending = IsDescendingComparator<Comparator>::value;
+        if constexpr (IsPair<T>::value && std::is_same<KeyExtractor, RadixIdentity>::value) {
+            RadixSortRange(data, n, [](const T& item) { return item.second; }, descending);
+            RadixSortRange(data, n, [](const T& item) { return item.first; }, descending);
+        } else {
+            RadixSortRange(data, n, key, descending);
+        }
+    }
+};
+
+#endif //RADIXSORT_H
@@ -1,20 +1,26 @@
 #ifndef SELECTIONSORT_H
 #define SELECTIONSORT_H
 #include "ISorter.h"
+#include <utility>
+
 template <typename T, typename Comparator>
-class SelectionSort : public ISorter<T, Comparator> {
-public:
-    void Sort(ShrdPtr<Sequence<T>> sequence, Comparator comp) override {
-        size_t n = sequence->GetLength();
-        for (size_t i = 0; i < n; ++i) {
-            size_t min_idx = i;
-            for (size_t j = i + 1; j < n; ++j) {
-                if (comp(sequence->Get(j), sequence->Get(min_idx))) {
-                    min_idx = j;
-                }
+void SelectionSortRange(T* data, size_t n, Comparator& comp) {
+    for (size_t i = 0; i < n; ++i) {
+        size_t min_idx = i;
+        for (size_t j = i + 1; j < n; ++j) {
+            if (comp(data[j], data[min_idx])) {
+                min_idx = j;
             }
-            std::swap(sequence->Get(min_idx), sequence->Get(i));
         }
+        std::swap(data[min_idx], data[i]);
+    }
+}
+
+template <typename T, typename Comparator>
+class SelectionSort : public RangeSorter<SelectionSort<T, Comparator>, T, Comparator> {
+public:
+    void SortRange(T* data, size_t n, Comparator comp) {
+        SelectionSortRange(data, n, comp);
     }
 };
 
@@ -1,21 +1,27 @@
 #ifndef SHELLSORT_H
 #define SHELLSORT_H
 #include "ISorter.h"
+#include <utility>
+
 template <typename T, typename Comparator>
-class ShellSort : public ISorter<T, Comparator> {
-public:
-    void Sort(ShrdPtr<Sequence<T>> sequence, Comparator comp) override {
-        size_t n = sequence->GetLength();
-        for (int gap = n / 2; gap > 0; gap /= 2) {
-            for (int i = gap; i < n; i++) {
-                T temp = sequence->Get(i);
-                int j;
-                for (j = i; j >= gap && comp(temp, sequence->Get(j - gap)); j -= gap) {
-                    sequence->Set(j, sequence->Get(j - gap));
-                }
-                sequence->Set(j, temp);
+void ShellSortRange(T* data, size_t n, Comparator& comp) {
+    for (size_t gap = n / 2; gap > 0; gap /= 2) {
+        for (size_t i = gap; i < n; ++i) {
+            T temp = std::move(data[i]);
+            size_t j;
+            for (j = i; j >= gap && comp(temp, data[j - gap]); j -= gap) {
+                data[j] = std::move(data[j - gap]);
             }
+            data[j] = std::move(temp);
         }
     }
+}
+
+template <typename T, typename Comparator>
+class ShellSort : public RangeSorter<ShellSort<T, Comparator>, T, Comparator> {
+public:
+    void SortRange(T* data, size_t n, Comparator comp) {
+        ShellSortRange(data, n, comp);
+    }
 };
 #endif //SHELLSORT_H
@@ -0,0 +1,330 @@
+#ifndef SORTINGNETWORKS_H
+#define SORTINGNETWORKS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Сортирующие сети для блоков до 64 элементов. Для int32/float/int64/double с std::less
+// при сборке с AVX2 блок сортируется в регистрах (битоническая сортировка), иначе используется
+// скалярная сеть Бэтчера (чётно-нечётное слияние) с обменами без ветвлений.
+
+constexpr size_t NetworkBlockSize = 64;
+
+// Компараторы сети Бэтчера для 64 входов; компараторы с индексом >= n пропускаются,
+// что равносильно дополнению блока значениями +бесконечность
+struct BatcherNetwork {
+    static constexpr size_t Size = 543;
+    uint8_t low[Size];
+    uint8_t high[Size];
+
+    constexpr BatcherNetwork() : low(), high() {
+        size_t count = 0;
+        for (size_t p = 1; p < NetworkBlockSize; p <<= 1) {
+            for (size_t k = p; k >= 1; k >>= 1) {
+                for (size_t j = k % p; j + k < NetworkBlockSize; j += 2 * k) {
+                    for (size_t i = 0; i < k && i + j + k < NetworkBlockSize; ++i) {
+                        if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                            low[count] = static_cast<uint8_t>(i + j);
+                            high[count] = static_cast<uint8_t>(i + j + k);
+                            ++count;
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+template <typename T, typename Comparator>
+struct IsBranchlessCompare
+    : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+                                   (std::is_same<Comparator, std::less<T>>::value ||
+                                    std::is_same<Comparator, std::less<>>::value)> {};
+
+template <typename T, typename Comparator>
+void CompareExchange(T& a, T& b, Comparator& comp) {
+    if constexpr (IsBranchlessCompare<T, Comparator>::value) {
+        T x = a;
+        T y = b;
+        bool swapped = y < x;
+        a = swapped ? y : x;
+        b = swapped ? x : y;
+    } else if (comp(b, a)) {
+        std::swap(a, b);
+    }
+}
+
+template <typename T, typename Comparator>
+void ScalarNetworkSort(T* data, size_t n, Comparator& comp) {
+    static constexpr BatcherNetwork network;
+    for (size_t c = 0; c < BatcherNetwork::Size; ++c) {
+        if (network.high[c] < n) {
+            CompareExchange(data[network.low[c]], data[network.high[c]], comp);
+        }
+    }
+}
+
+#if defined(__AVX2__)
+
+// Операции над регистром для битонической сортировки. Каждая ступень — сравнение с соседом
+// по перестановке и выбор максимума в дорожках из маски
+struct NetworkInt32 {
+    using Scalar = int32_t;
+    using Vector = __m256i;
+    static constexpr size_t Lanes = 8;
+
+    static Vector Load(const Scalar* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void Store(Scalar* p, Vector v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    static Vector Min(Vector a, Vector b) { return _mm256_min_epi32(a, b); }
+    static Vector Max(Vector a, Vector b) { return _mm256_max_epi32(a, b); }
+    static Vector Reverse(Vector v) { return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+
+    template <int Mask>
+    static Vector Step(Vector v, Vector partner) {
+        return _mm256_blend_epi32(Min(v, partner), Max(v, partner), Mask);
+    }
+
+    static Vector SwapHalves(Vector v) { return _mm256_permute2x128_si256(v, v, 1); }
+    static Vector SwapPairs(Vector v) { return _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)); }
+    static Vector SwapAdjacent(Vector v) { return _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static Vector ReverseQuads(Vector v) { return _mm256_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)); }
+
+    static Vector SortInRegister(Vector v) {
+        v = Step<0xAA>(v, SwapAdjacent(v));
+        v = Step<0xCC>(v, ReverseQuads(v));
+        v = Step<0xAA>(v, SwapAdjacent(v));
+        v = Step<0xF0>(v, Reverse(v));
+        v = Step<0xCC>(v, SwapPairs(v));
+        return Step<0xAA>(v, SwapAdjacent(v));
+    }
+
+    static Vector CleanInRegister(Vector v) {
+        v = Step<0xF0>(v, SwapHalves(v));
+        v = Step<0xCC>(v, SwapPairs(v));
+        return Step<0xAA>(v, SwapAdjacent(v));
+    }
+};
+
+struct NetworkFloat {
+    using Scalar = float;
+    using Vector = __m256;
+    static constexpr size_t Lanes = 8;
+
+    static Vector Load(const Scalar* p) { return _mm256_load_ps(p); }
+    static void Store(Scalar* p, Vector v) { _mm256_store_ps(p, v); }
+    static Vector Min(Vector a, Vector b) { return _mm256_min_ps(a, b); }
+    static Vector Max(Vector a, Vector b) { return _mm256_max_ps(a, b); }
+    static Vector Reverse(Vector v) { return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+
+    template <int Mask>
+    static Vector Step(Vector v, Vector partner) {
+        return _mm256_blend_ps(Min(v, partner), Max(v, partner), Mask);
+    }
+
+    static Vector SwapHalves(Vector v) { return _mm256_permute2f128_ps(v, v, 1); }
+    static Vector SwapPairs(Vector v) { return _mm256_permute_ps(v, _MM_SHUFFLE(1, 0, 3, 2)); }
+    static Vector SwapAdjacent(Vector v) { return _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static Vector ReverseQuads(Vector v) { return _mm256_permute_ps(v, _MM_SHUFFLE(0, 1, 2, 3)); }
+
+    static Vector SortInRegister(Vector v) {
+        v = Step<0xAA>(v, SwapAdjacent(v));
+        v = Step<0xCC>(v, ReverseQuads(v));
+        v = Step<0xAA>(v, SwapAdjacent(v));
+        v = Step<0xF0>(v, Reverse(v));
+        v = Step<0xCC>(v, SwapPairs(v));
+        return Step<0xAA>(v, SwapAdjacent(v));
+    }
+
+    static Vector CleanInRegister(Vector v) {
+        v = Step<0xF0>(v, SwapHalves(v));
+        v = Step<0xCC>(v, SwapPairs(v));
+        return Step<0xAA>(v, SwapAdjacent(v));
+    }
+};
+
+// В AVX2 нет min/max для 64-битных целых: они собираются из сравнения и blendv
+struct NetworkInt64 {
+    using Scalar = int64_t;
+    using Vector = __m256i;
+    static constexpr size_t Lanes = 4;
+
+    static Vector Load(const Scalar* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void Store(Scalar* p, Vector v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    static Vector Min(Vector a, Vector b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+    static Vector Max(Vector a, Vector b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+    static Vector Reverse(Vector v) { return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3)); }
+
+    template <int Mask>
+    static Vector Step(Vector v, Vector partner) {
+        return _mm256_blend_epi32(Min(v, partner), Max(v, partner), Mask);
+    }
+
+    static Vector SwapHalves(Vector v) { return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2)); }
+    static Vector SwapAdjacent(Vector v) { return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+
+    // Маски blend_epi32 заданы в 32-битных дорожках: 0xCC — элементы 1 и 3, 0xF0 — элементы 2 и 3
+    static Vector SortInRegister(Vector v) {
+        v = Step<0xCC>(v, SwapAdjacent(v));
+        v = Step<0xF0>(v, Reverse(v));
+        return Step<0xCC>(v, SwapAdjacent(v));
+    }
+
+    static Vector CleanInRegister(Vector v) {
+        v = Step<0xF0>(v, SwapHalves(v));
+        return Step<0xCC>(v, SwapAdjacent(v));
+    }
+};
+
+struct NetworkDouble {
+    using Scalar = double;
+    using Vector = __m256d;
+    static constexpr size_t Lanes = 4;
+
+    static Vector Load(const Scalar* p) { return _mm256_load_pd(p); }
+    static void Store(Scalar* p, Vector v) { _mm256_store_pd(p, v); }
+    static Vector Min(Vector a, Vector b) { return _mm256_min_pd(a, b); }
+    static Vector Max(Vector a, Vector b) { return _mm256_max_pd(a, b); }
+    static Vector Reverse(Vector v) { return _mm256_permute4x64_pd(v, _MM_SHUFFLE(0, 1, 2, 3)); }
+
+    template <int Mask>
+    static Vector Step(Vector v, Vector partner) {
+        return _mm256_blend_pd(Min(v, partner), Max(v, partner), Mask);
+    }
+
+    static Vector SwapHalves(Vector v) { return _mm256_permute2f128_pd(v, v, 1); }
+    static Vector SwapAdjacent(Vector v) { return _mm256_permute_pd(v, 0x5); }
+
+    static Vector SortInRegister(Vector v) {
+        v = Step<0xA>(v, SwapAdjacent(v));
+        v = Step<0xC>(v, Reverse(v));
+        return Step<0xA>(v, SwapAdjacent(v));
+    }
+
+    static Vector CleanInRegister(Vector v) {
+        v = Step<0xC>(v, SwapHalves(v));
+        return Step<0xA>(v, SwapAdjacent(v));
+    }
+};
+
+template <typename T>
+struct NetworkTraits {
+    using Type = void;
+};
+
+template <>
+struct NetworkTraits<int32_t> {
+    using Type = NetworkInt32;
+};
+
+template <>
+struct NetworkTraits<float> {
+    using Type = NetworkFloat;
+};
+
+template <>
+struct NetworkTraits<int64_t> {
+    using Type = NetworkInt64;
+};
+
+template <>
+struct NetworkTraits<double> {
+    using Type = NetworkDouble;
+};
+
+// Сливает два отсортированных отрезка по m регистров: второй разворачивается, попарные min/max
+// дают две битонические половины, которые досортировываются по регистрам, затем внутри регистров
+template <typename Traits>
+void NetworkMergeRuns(typename Traits::Vector* regs, size_t m) {
+    using Vector = typename Traits::Vector;
+    Vector merged[2 * NetworkBlockSize / Traits::Lanes];
+    for (size_t i = 0; i < m; ++i) {
+        Vector reversed = Traits::Reverse(regs[2 * m - 1 - i]);
+        merged[i] = Traits::Min(regs[i], reversed);
+        merged[m + i] = Traits::Max(regs[i], reversed);
+    }
+    for (size_t half = 0; half < 2 * m; half += m) {
+        for (size_t distance = m / 2; distance >= 1; distance /= 2) {
+            for (size_t i = half; i < half + m; ++i) {
+                if ((i - half) & distance) {
+                    continue;
+                }
+                Vector low = Traits::Min(merged[i], merged[i + distance]);
+                merged[i + distance] = Traits::Max(merged[i], merged[i + distance]);
+                merged[i] = low;
+            }
+        }
+    }
+    for (size_t i = 0; i < 2 * m; ++i) {
+        regs[i] = Traits::CleanInRegister(merged[i]);
+    }
+}
+
+template <typename Traits>
+void SimdNetworkSort(typename Traits::Scalar* data, size_t n) {
+    using Scalar = typename Traits::Scalar;
+    using Vector = typename Traits::Vector;
+    constexpr size_t maxRegisters = NetworkBlockSize / Traits::Lanes;
+
+    alignas(32) Scalar buffer[NetworkBlockSize];
+    std::memcpy(buffer, data, n * sizeof(Scalar));
+    size_t registers = 1;
+    while (registers * Traits::Lanes < n) {
+        registers *= 2;
+    }
+    const Scalar fill = std::numeric_limits<Scalar>::has_infinity ? std::numeric_limits<Scalar>::infinity()
+                                                                  : std::numeric_limits<Scalar>::max();
+    for (size_t i = n; i < registers * Traits::Lanes; ++i) {
+        buffer[i] = fill;
+    }
+
+    Vector regs[maxRegisters];
+    for (size_t i = 0; i < registers; ++i) {
+        regs[i] = Traits::SortInRegister(Traits::Load(buffer + i * Traits::Lanes));
+    }
+    for (size_t width = 1; width < registers; width *= 2) {
+        for (size_t start = 0; start < registers; start += 2 * width) {
+            NetworkMergeRuns<Traits>(regs + start, width);
+        }
+    }
+    for (size_t i = 0; i < registers; ++i) {
+        Traits::Store(buffer + i * Traits::Lanes, regs[i]);
+    }
+    std::memcpy(data, buffer, n * sizeof(Scalar));
+}
+
+template <typename T, typename Comparator>
+struct HasSimdNetwork
+    : std::integral_constant<bool, !std::is_void<typename NetworkTraits<T>::Type>::value &&
+                                   IsBranchlessCompare<T, Comparator>::value> {};
+
+#else
+
+template <typename T, typename Comparator>
+struct HasSimdNetwork : std::false_type {};
+
+#endif
+
+// Сортирует блок из n <= NetworkBlockSize элементов. NaN в float/double дают неопределённый порядок
+template <typename T, typename Comparator>
+void NetworkSortBlock(T* data, size_t n, Comparator& comp) {
+    if (n < 2) {
+        return;
+    }
+#if defined(__AVX2__)
+    if constexpr (HasSimdNetwork<T, Comparator>::value) {
+        SimdNetworkSort<typename NetworkTraits<T>::Type>(data, n);
+        return;
+    }
+#endif
+    ScalarNetworkSort(data, n, comp);
+}
+
+#endif //SORTINGNETWORKS_H
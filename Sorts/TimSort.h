@@ -0,0 +1,460 @@
+#ifndef TIMSORT_H
+#define TIMSORT_H
+#include "ISorter.h"
+#include "DynamicArray.h"
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+// Устойчивая адаптивная сортировка (TimSort): естественные серии дополняются бинарными вставками
+// до minRun, серии сливаются со стеком инвариантов и режимом «галопа» при длинных перевесах одной серии.
+// Буфер слияния хранится в сортировщике и переиспользуется между вызовами Sort.
+template <typename T, typename Comparator>
+class TimSort : public RangeSorter<TimSort<T, Comparator>, T, Comparator> {
+private:
+    static constexpr ptrdiff_t minGallop = 7;
+    static constexpr size_t minMerge = 32;
+
+    struct Run {
+        ptrdiff_t start;
+        ptrdiff_t length;
+    };
+
+    DynamicArray<T> buffer;
+    DynamicArray<Run> runs;
+    ptrdiff_t gallopThreshold;
+    T* data;
+    Comparator* comp;
+
+    static size_t minRunLength(size_t n) {
+        size_t r = 0;
+        while (n >= minMerge) {
+            r |= n & 1;
+            n >>= 1;
+        }
+        return n + r;
+    }
+
+    size_t countRunAndMakeAscending(size_t lo, size_t hi) {
+        size_t runHi = lo + 1;
+        if (runHi == hi) {
+            return 1;
+        }
+        if ((*comp)(data[runHi++], data[lo])) {
+            while (runHi < hi && (*comp)(data[runHi], data[runHi - 1])) {
+                ++runHi;
+            }
+            std::reverse(data + lo, data + runHi);
+        } else {
+            while (runHi < hi && !(*comp)(data[runHi], data[runHi - 1])) {
+                ++runHi;
+            }
+        }
+        return runHi - lo;
+    }
+
+    // [lo, start) уже отсортирован; равные элементы вставляются после существующих
+    void binaryInsertionSort(size_t lo, size_t hi, size_t start) {
+        for (; start < hi; ++start) {
+            T pivot = std::move(data[start]);
+            size_t left = lo;
+            size_t right = start;
+            while (left < right) {
+                size_t middle = left + (right - left) / 2;
+                if ((*comp)(pivot, data[middle])) {
+                    right = middle;
+                } else {
+                    left = middle + 1;
+                }
+            }
+            std::move_backward(data + left, data + start, data + start + 1);
+            data[left] = std::move(pivot);
+        }
+    }
+
+    // Первая позиция k, где key <= a[k]; поиск начинается от hint
+    ptrdiff_t gallopLeft(const T& key, const T* a, ptrdiff_t length, ptrdiff_t hint) const {
+        ptrdiff_t lastOffset = 0;
+        ptrdiff_t offset = 1;
+        if ((*comp)(a[hint], key)) {
+            ptrdiff_t maxOffset = length - hint;
+            while (offset < maxOffset && (*comp)(a[hint + offset], key)) {
+                lastOffset = offset;
+                offset = offset * 2 + 1;
+            }
+            if (offset > maxOffset) {
+                offset = maxOffset;
+            }
+            lastOffset += hint;
+            offset += hint;
+        } else {
+            ptrdiff_t maxOffset = hint + 1;
+            while (offset < maxOffset && !(*comp)(a[hint - offset], key)) {
+                lastOffset = offset;
+                offset = offset * 2 + 1;
+            }
+            if (offset > maxOffset) {
+                offset = maxOffset;
+            }
+            ptrdiff_t previous = lastOffset;
+            lastOffset = hint - offset;
+            offset = hint - previous;
+        }
+        ++lastOffset;
+        while (lastOffset < offset) {
+            ptrdiff_t middle = lastOffset + (offset - lastOffset) / 2;
+            if ((*comp)(a[middle], key)) {
+                lastOffset = middle + 1;
+            } else {
+                offset = middle;
+            }
+        }
+        return offset;
+    }
+
+    // Первая позиция k, где key < a[k]; поиск начинается от hint
+    ptrdiff_t gallopRight(const T& key, const T* a, ptrdiff_t length, ptrdiff_t hint) const {
+        ptrdiff_t lastOffset = 0;
+        ptrdiff_t offset = 1;
+        if ((*comp)(key, a[hint])) {
+            ptrdiff_t maxOffset = hint + 1;
+            while (offset < maxOffset && (*comp)(key, a[hint - offset])) {
+                lastOffset = offset;
+                offset = offset * 2 + 1;
+            }
+            if (offset > maxOffset) {
+                offset = maxOffset;
+            }
+            ptrdiff_t previous = lastOffset;
+            lastOffset = hint - offset;
+            offset = hint - previous;
+        } else {
+            ptrdiff_t maxOffset = length - hint;
+            while (offset < maxOffset && !(*comp)(key, a[hint + offset])) {
+                lastOffset = offset;
+                offset = offset * 2 + 1;
+            }
+            if (offset > maxOffset) {
+                offset = maxOffset;
+            }
+            lastOffset += hint;
+            offset += hint;
+        }
+        ++lastOffset;
+        while (lastOffset < offset) {
+            ptrdiff_t middle = lastOffset + (offset - lastOffset) / 2;
+            if ((*comp)(key, a[middle])) {
+                offset = middle;
+            } else {
+                lastOffset = middle + 1;
+            }
+        }
+        return offset;
+    }
+
+    T* fillBuffer(ptrdiff_t start, ptrdiff_t length) {
+        buffer.Clear();
+        buffer.Reserve(length);
+        for (ptrdiff_t i = 0; i < length; ++i) {
+            buffer.PushBack(std::move(data[start + i]));
+        }
+        return buffer.Data();
+    }
+
+    // Основной цикл mergeLo; возврат из функции соответствует выходу из слияния
+    void mergeLoLoop(T* tmp, ptrdiff_t& cursor1, ptrdiff_t& length1, ptrdiff_t& cursor2, ptrdiff_t& length2,
+                     ptrdiff_t& dest, ptrdiff_t& gallop) {
+        T* a = data;
+        while (true) {
+            ptrdiff_t count1 = 0;
+            ptrdiff_t count2 = 0;
+            do {
+                if ((*comp)(a[cursor2], tmp[cursor1])) {
+                    a[dest++] = std::move(a[cursor2++]);
+                    ++count2;
+                    count1 = 0;
+                    if (--length2 == 0) {
+                        return;
+                    }
+                } else {
+                    a[dest++] = std::move(tmp[cursor1++]);
+                    ++count1;
+                    count2 = 0;
+                    if (--length1 == 1) {
+                        return;
+                    }
+                }
+            } while ((count1 | count2) < gallop);
+
+            do {
+                count1 = gallopRight(a[cursor2], tmp + cursor1, length1, 0);
+                if (count1 != 0) {
+                    std::move(tmp + cursor1, tmp + cursor1 + count1, a + dest);
+                    dest += count1;
+                    cursor1 += count1;
+                    length1 -= count1;
+                    if (length1 <= 1) {
+                        return;
+                    }
+                }
+                a[dest++] = std::move(a[cursor2++]);
+                if (--length2 == 0) {
+                    return;
+                }
+                count2 = gallopLeft(tmp[cursor1], a + cursor2, length2, 0);
+                if (count2 != 0) {
+                    std::move(a + cursor2, a + cursor2 + count2, a + dest);
+                    dest += count2;
+                    cursor2 += count2;
+                    length2 -= count2;
+                    if (length2 == 0) {
+                        return;
+                    }
+                }
+                a[dest++] = std::move(tmp[cursor1++]);
+                if (--length1 == 1) {
+                    return;
+                }
+                --gallop;
+            } while (count1 >= minGallop || count2 >= minGallop);
+            if (gallop < 0) {
+                gallop = 0;
+            }
+            gallop += 2;
+        }
+    }
+
+    // Первая серия короче: она переносится в буфер, слияние идёт слева направо
+    void mergeLo(ptrdiff_t base1, ptrdiff_t length1, ptrdiff_t base2, ptrdiff_t length2) {
+        T* a = data;
+        T* tmp = fillBuffer(base1, length1);
+        ptrdiff_t cursor1 = 0;
+        ptrdiff_t cursor2 = base2;
+        ptrdiff_t dest = base1;
+
+        a[dest++] = std::move(a[cursor2++]);
+        if (--length2 == 0) {
+            std::move(tmp, tmp + length1, a + dest);
+            return;
+        }
+        if (length1 == 1) {
+            std::move(a + cursor2, a + cursor2 + length2, a + dest);
+            a[dest + length2] = std::move(tmp[cursor1]);
+            return;
+        }
+
+        ptrdiff_t gallop = gallopThreshold;
+        mergeLoLoop(tmp, cursor1, length1, cursor2, length2, dest, gallop);
+        gallopThreshold = gallop < 1 ? 1 : gallop;
+
+        if (length1 == 1) {
+            std::move(a + cursor2, a + cursor2 + length2, a + dest);
+            a[dest + length2] = std::move(tmp[cursor1]);
+        } else {
+            std::move(tmp + cursor1, tmp + cursor1 + length1, a + dest);
+        }
+    }
+
+    void mergeHiLoop(T* tmp, ptrdiff_t base1, ptrdiff_t& cursor1, ptrdiff_t& length1, ptrdiff_t& cursor2,
+                     ptrdiff_t& length2, ptrdiff_t& dest, ptrdiff_t& gallop) {
+        T* a = data;
+        while (true) {
+            ptrdiff_t count1 = 0;
+            ptrdiff_t count2 = 0;
+            do {
+                if ((*comp)(tmp[cursor2], a[cursor1])) {
+                    a[dest--] = std::move(a[cursor1--]);
+                    ++count1;
+                    count2 = 0;
+                    if (--length1 == 0) {
+                        return;
+                    }
+                } else {
+                    a[dest--] = std::move(tmp[cursor2--]);
+                    ++count2;
+                    count1 = 0;
+                    if (--length2 == 1) {
+                        return;
+                    }
+                }
+            } while ((count1 | count2) < gallop);
+
+            do {
+                count1 = length1 - gallopRight(tmp[cursor2], a + base1, length1, length1 - 1);
+                if (count1 != 0) {
+                    dest -= count1;
+                    cursor1 -= count1;
+                    length1 -= count1;
+                    std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + count1, a + dest + 1 + count1);
+                    if (length1 == 0) {
+                        return;
+                    }
+                }
+                a[dest--] = std::move(tmp[cursor2--]);
+                if (--length2 == 1) {
+                    return;
+                }
+                count2 = length2 - gallopLeft(a[cursor1], tmp, length2, length2 - 1);
+                if (count2 != 0) {
+                    dest -= count2;
+                    cursor2 -= count2;
+                    length2 -= count2;
+                    std::move(tmp + cursor2 + 1, tmp + cursor2 + 1 + count2, a + dest + 1);
+                    if (length2 <= 1) {
+                        return;
+                    }
+                }
+                a[dest--] = std::move(a[cursor1--]);
+                if (--length1 == 0) {
+                    return;
+                }
+                --gallop;
+            } while (count1 >= minGallop || count2 >= minGallop);
+            if (gallop < 0) {
+                gallop = 0;
+            }
+            gallop += 2;
+        }
+    }
+
+    // Вторая серия короче: она переносится в буфер, слияние идёт справа налево
+    void mergeHi(ptrdiff_t base1, ptrdiff_t length1, ptrdiff_t base2, ptrdiff_t length2) {
+        T* a = data;
+        T* tmp = fillBuffer(base2, length2);
+        ptrdiff_t cursor1 = base1 + length1 - 1;
+        ptrdiff_t cursor2 = length2 - 1;
+        ptrdiff_t dest = base2 + length2 - 1;
+
+        a[dest--] = std::move(a[cursor1--]);
+        if (--length1 == 0) {
+            std::move(tmp, tmp + length2, a + dest - (length2 - 1));
+            return;
+        }
+        if (length2 == 1) {
+            dest -= length1;
+            cursor1 -= length1;
+            std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + length1, a + dest + 1 + length1);
+            a[dest] = std::move(tmp[cursor2]);
+            return;
+        }
+
+        ptrdiff_t gallop = gallopThreshold;
+        mergeHiLoop(tmp, base1, cursor1, length1, cursor2, length2, dest, gallop);
+        gallopThreshold = gallop < 1 ? 1 : gallop;
+
+        if (length2 == 1) {
+            dest -= length1;
+            cursor1 -= length1;
+            std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + length1, a + dest + 1 + length1);
+            a[dest] = std::move(tmp[cursor2]);
+        } else {
+            std::move(tmp, tmp + length2, a + dest - (length2 - 1));
+        }
+    }
+
+    void mergeAt(size_t i) {
+        ptrdiff_t base1 = runs.UncheckedGet(i).start;
+        ptrdiff_t length1 = runs.UncheckedGet(i).length;
+        ptrdiff_t base2 = runs.UncheckedGet(i + 1).start;
+        ptrdiff_t length2 = runs.UncheckedGet(i + 1).length;
+
+        runs.UncheckedGet(i).length = length1 + length2;
+        if (i + 3 == runs.GetSize()) {
+            runs.UncheckedGet(i + 1) = runs.UncheckedGet(i + 2);
+        }
+        runs.PopBack();
+
+        // Начало первой серии, которое меньше первого элемента второй, уже на месте; так же и хвост второй
+        ptrdiff_t skipped = gallopRight(data[base2], data + base1, length1, 0);
+        base1 += skipped;
+        length1 -= skipped;
+        if (length1 == 0) {
+            return;
+        }
+        length2 = gallopLeft(data[base1 + length1 - 1], data + base2, length2, length2 - 1);
+        if (length2 == 0) {
+            return;
+        }
+
+        if (length1 <= length2) {
+            mergeLo(base1, length1, base2, length2);
+        } else {
+            mergeHi(base1, length1, base2, length2);
+        }
+    }
+
+    ptrdiff_t runLength(size_t i) const {
+        return runs.UncheckedGet(i).length;
+    }
+
+    // Инварианты стека серий проверяются и для трёх верхних серий, и для четырёх
+    void mergeCollapse() {
+        while (runs.GetSize() > 1) {
+            size_t n = runs.GetSize() - 2;
+            if ((n > 0 && runLength(n - 1) <= runLength(n) + runLength(n + 1)) ||
+                (n > 1 && runLength(n - 2) <= runLength(n - 1) + runLength(n))) {
+                if (runLength(n - 1) < runLength(n + 1)) {
+                    --n;
+                }
+            } else if (runLength(n) > runLength(n + 1)) {
+                break;
+            }
+            mergeAt(n);
+        }
+    }
+
+    void mergeForceCollapse() {
+        while (runs.GetSize() > 1) {
+            size_t n = runs.GetSize() - 2;
+            if (n > 0 && runLength(n - 1) < runLength(n + 1)) {
+                --n;
+            }
+            mergeAt(n);
+        }
+    }
+
+public:
+    TimSort() : gallopThreshold(minGallop), data(nullptr), comp(nullptr) {}
+
+    void SortRange(T* items, size_t n, Comparator comparator) {
+        if (n < 2) {
+            return;
+        }
+        data = items;
+        comp = &comparator;
+        gallopThreshold = minGallop;
+        runs.Clear();
+
+        if (n < minMerge) {
+            binaryInsertionSort(0, n, countRunAndMakeAscending(0, n));
+            return;
+        }
+
+        size_t minRun = minRunLength(n);
+        size_t lo = 0;
+        size_t remaining = n;
+        do {
+            size_t length = countRunAndMakeAscending(lo, n);
+            if (length < minRun) {
+                size_t forced = remaining < minRun ? remaining : minRun;
+                binaryInsertionSort(lo, lo + forced, lo + length);
+                length = forced;
+            }
+            runs.PushBack({static_cast<ptrdiff_t>(lo), static_cast<ptrdiff_t>(length)});
+            mergeCollapse();
+            lo += length;
+            remaining -= length;
+        } while (remaining != 0);
+
+        mergeForceCollapse();
+        buffer.Clear();
+    }
+};
+
+template <typename T, typename Comparator>
+void TimSortRange(T* data, size_t n, Comparator comp) {
+    TimSort<T, Comparator> sorter;
+    sorter.SortRange(data, n, comp);
+}
+
+#endif //TIMSORT_H
@@ -1,9 +1,521 @@
 #include <cassert>
+#include <iostream>
 #include "UndirectedGraph.h"
 #include "Test.h"
 #include "DirectedGraph.h"
+#include "GraphGenerators.h"
+#include "DynamicArray.h"
+#include "LinkedList.h"
+#include "DequeSequence.h"
+#include "SequenceOperations.h"
+#include "Arena.h"
+#include "Pool.h"
+#ifndef _WIN32
+#include "MappedArraySequence.h"
+#include "MappedGraph.h"
+#include "GraphLoader.h"
+#include <cstdio>
+#endif
+#include <string>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <thread>
+#include <random>
+#include "BubbleSort.h"
+#include "HeapSort.h"
+#include "InsertionSort.h"
+#include "QuickSort.h"
+#include "SelectionSort.h"
+#include "ShellSort.h"
+#include "ParallelSort.h"
+#include "RadixSort.h"
+#include "NetworkSort.h"
+#include "TimSort.h"
+#include "ExternalSort.h"
+#include "PartialSort.h"
+#include "ArgSort.h"
 
 
+void TestDynamicArray() {
+    DynamicArray<UnqPtr<int>> owners;
+    for (int i = 0; i < 100; ++i) {
+        owners.PushBack(UnqPtr<int>(new int(i)));
+    }
+    assert(owners.GetSize() == 100);
+    assert(*owners.Get(99) == 99);
+
+    struct NoDefault {
+        std::string name;
+        explicit NoDefault(std::string name) : name(std::move(name)) {}
+    };
+    ArraySequence<NoDefault> named;
+    named.Emplace("a");
+    named.Add(NoDefault("b"));
+    auto prepended = named.Prepend(NoDefault("c"));
+    assert(prepended->GetLength() == 3);
+    assert(prepended->Get(0).name == "c");
+    assert(prepended->Get(2).name == "b");
+
+    DynamicArray<double> values(3);
+    values.Resize(1000);
+    assert(values.Get(0) == 0.0 && values.Get(999) == 0.0);
+    values.Resize(2);
+    assert(values.GetSize() == 2);
+}
+
+void TestArraySequenceAccess() {
+    int raw[] = {5, 3, 9, 1, 7};
+    ArraySequence<int> sequence(raw, 5);
+    std::sort(sequence.begin(), sequence.end());
+    assert(sequence.Get(0) == 1 && sequence.Get(4) == 9);
+    assert(std::accumulate(sequence.begin(), sequence.end(), 0) == 25);
+    assert(sequence.Data()[2] == 5);
+
+    auto span = sequence.AsSpan().Subspan(1, 3);
+    assert(span.GetLength() == 3 && span[0] == 3 && span[2] == 7);
+
+    bool thrown = false;
+    try {
+        sequence.Get(5);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+template <typename Sorter>
+void CheckSorter() {
+    int raw[] = {4, -2, 8, 8, 0, 15, -7, 3, 3, 1};
+    ShrdPtr<ArraySequence<int>> sequence(new ArraySequence<int>(raw, 10));
+    Sorter sorter;
+    ISorter<int, std::less<int>>& erased = sorter;
+    erased.Sort(sequence, std::less<int>());
+    assert(std::is_sorted(sequence->begin(), sequence->end()));
+
+    sorter.Sort(raw, raw + 10, std::less<int>());
+    assert(std::is_sorted(raw, raw + 10));
+
+    // Итераторы дека не непрерывны: сортировка идёт через буфер
+    DequeSequence<int> deque;
+    for (int i = 0; i < 300; ++i) {
+        deque.PushFront(i * 37 % 101);
+    }
+    sorter.Sort(deque.begin(), deque.end(), std::less<int>());
+    assert(std::is_sorted(deque.begin(), deque.end()));
+}
+
+// Отсортированный, обратный, из повторов и «пила»: на них наивная быстрая сортировка деградирует
+template <typename Sorter>
+void CheckSorterOnPatterns(size_t n) {
+    for (int pattern = 0; pattern < 4; ++pattern) {
+        auto sequence = MakeShrd<ArraySequence<int>>();
+        for (size_t i = 0; i < n; ++i) {
+            int values[] = {static_cast<int>(i), static_cast<int>(n - i), static_cast<int>(i % 3), static_cast<int>(i % 100)};
+            sequence->Add(values[pattern]);
+        }
+        Sorter sorter;
+        sorter.Sort(sequence, std::less<int>());
+        assert(std::is_sorted(sequence->begin(), sequence->end()));
+    }
+}
+
+void TestSorters() {
+    CheckSorter<BubbleSort<int, std::less<int>>>();
+    CheckSorter<HeapSort<int, std::less<int>>>();
+    CheckSorter<InsertionSort<int, std::less<int>>>();
+    CheckSorter<QuickSort<int, std::less<int>>>();
+    CheckSorter<SelectionSort<int, std::less<int>>>();
+    CheckSorter<ShellSort<int, std::less<int>>>();
+    CheckSorterOnPatterns<QuickSort<int, std::less<int>>>(100000);
+    CheckSorterOnPatterns<HeapSort<int, std::less<int>>>(10000);
+    CheckSorter<ParallelSort<int, std::less<int>>>();
+
+    ThreadPool pool(3);
+    auto strings = MakeShrd<ArraySequence<std::string>>();
+    for (size_t i = 0; i < 100000; ++i) {
+        strings->Add(std::to_string(i * 7919 % 100003));
+    }
+    ParallelSort<std::string, std::less<std::string>> parallel(pool);
+    parallel.Sort(strings, std::less<std::string>());
+    assert(std::is_sorted(strings->begin(), strings->end()));
+
+    CheckSorter<RadixSort<int, std::less<int>>>();
+    CheckSorterOnPatterns<RadixSort<int, std::less<int>>>(10000);
+
+    auto distances = MakeShrd<ArraySequence<double>>();
+    for (int i = 0; i < 1000; ++i) {
+        distances->Add((i * 37 % 101 - 50) * 0.25);
+    }
+    RadixSort<double, std::greater<double>> descending;
+    descending.Sort(distances, std::greater<double>());
+    assert(std::is_sorted(distances->begin(), distances->end(), std::greater<double>()));
+
+    auto edges = MakeShrd<ArraySequence<std::pair<size_t, int>>>();
+    for (size_t i = 0; i < 1000; ++i) {
+        edges->Add(std::make_pair(i % 7, static_cast<int>(500 - i)));
+    }
+    CheckSorter<NetworkSort<int, std::less<int>>>();
+    CheckSorterOnPatterns<NetworkSort<int, std::less<int>>>(5000);
+    for (size_t n = 0; n <= NetworkBlockSize; ++n) {
+        double block[NetworkBlockSize];
+        for (size_t i = 0; i < n; ++i) {
+            block[i] = static_cast<double>((i * 29) % 17) - 8.5;
+        }
+        std::less<double> less;
+        NetworkSortBlock(block, n, less);
+        assert(std::is_sorted(block, block + n));
+    }
+
+    CheckSorter<TimSort<int, std::less<int>>>();
+    CheckSorterOnPatterns<TimSort<int, std::less<int>>>(20000);
+
+    // Устойчивость: рёбра с равным весом сохраняют исходный порядок
+    using Edge = std::pair<int, size_t>;
+    auto byWeight = [](const Edge& a, const Edge& b) { return a.first < b.first; };
+    auto weighted = MakeShrd<ArraySequence<Edge>>();
+    for (size_t i = 0; i < 5000; ++i) {
+        weighted->Add(Edge(static_cast<int>(i * 31 % 17), i));
+    }
+    TimSort<Edge, decltype(byWeight)> stable;
+    stable.Sort(weighted, byWeight);
+    for (size_t i = 1; i < weighted->GetLength(); ++i) {
+        const Edge& previous = weighted->Get(i - 1);
+        const Edge& current = weighted->Get(i);
+        assert(previous.first < current.first || (previous.first == current.first && previous.second < current.second));
+    }
+
+    RadixSort<std::pair<size_t, int>> lexicographic;
+    lexicographic.Sort(edges, std::less<std::pair<size_t, int>>());
+    assert(std::is_sorted(edges->begin(), edges->end()));
+}
+
+void TestExternalSort() {
+    // Маленький бюджет: несколько серий и многопроходное слияние
+    using Record = std::pair<int, size_t>;
+    auto byKey = [](const Record& a, const Record& b) { return a.first < b.first; };
+    ExternalSort<Record, decltype(byKey)> external(64 * 1024, "", byKey);
+    external.SetSorter(MakeShrd<TimSort<Record, decltype(byKey)>>());
+    for (size_t i = 0; i < 100000; ++i) {
+        external.Add(Record(static_cast<int>(i * 7919 % 1009), i));
+    }
+    // Серия и буфер TimSort вместе укладываются в бюджет: по 64 КБ / 2 / sizeof(Record) элементов
+    assert(external.GetRunCount() == 100000 / (64 * 1024 / 2 / sizeof(Record)));
+
+    size_t count = 0;
+    Record previous(-1, 0);
+    external.Merge([&count, &previous](const Record& current) {
+        assert(previous.first < current.first || (previous.first == current.first && previous.second < current.second));
+        previous = current;
+        ++count;
+    });
+    assert(count == 100000 && external.GetRunCount() == 0);
+
+    // Сортировщик на месте получает весь бюджет под серию
+    ExternalSort<Record, decltype(byKey)> inPlace(64 * 1024, "", byKey);
+    inPlace.SetSorter(MakeShrd<HeapSort<Record, decltype(byKey)>>(), false);
+    for (size_t i = 0; i < 100000; ++i) {
+        inPlace.Add(Record(static_cast<int>(i * 7919 % 1009), i));
+    }
+    assert(inPlace.GetRunCount() == 100000 / (64 * 1024 / sizeof(Record)));
+
+    ExternalSort<int> small;
+    int values[] = {5, 3, 9, 1};
+    small.AddRange(values, 4);
+    std::string path = "lab4_external_test.bin";
+    small.MergeToFile(path);
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    int sorted[4] = {};
+    size_t read = std::fread(sorted, sizeof(int), 4, file);
+    std::fclose(file);
+    assert(read == 4 && sorted[0] == 1 && sorted[1] == 3 && sorted[2] == 5 && sorted[3] == 9);
+    std::remove(path.c_str());
+}
+
+void TestSelection() {
+    const size_t n = 20000;
+    ArraySequence<int> values;
+    for (size_t i = 0; i < n; ++i) {
+        values.Add(static_cast<int>(i * 7919 % n));
+    }
+    for (size_t k : {size_t(0), size_t(17), n / 2, n - 1}) {
+        ArraySequence<int> copy(values);
+        assert(NthElement(copy, k) == static_cast<int>(k));
+        assert(std::all_of(copy.begin(), copy.begin() + k, [k](int x) { return x <= static_cast<int>(k); }));
+    }
+
+    ArraySequence<int> partial(values);
+    PartialSort(partial, 100, std::greater<int>());
+    for (size_t i = 0; i < 100; ++i) {
+        assert(partial.Get(i) == static_cast<int>(n - 1 - i));
+    }
+
+    // Потоковый отбор k лёгких рёбер
+    TopK<std::pair<double, size_t>> lightest(10);
+    for (size_t i = 0; i < n; ++i) {
+        lightest.Push(std::make_pair(static_cast<double>(i * 31 % n), i));
+    }
+    auto best = lightest.GetSorted();
+    assert(best->GetLength() == 10 && lightest.GetThreshold().first == 9.0);
+    for (size_t i = 0; i < 10; ++i) {
+        assert(best->Get(i).first == static_cast<double>(i));
+    }
+}
+
+void TestArgSort() {
+    ArraySequence<std::pair<size_t, std::string>> records;
+    for (size_t i = 0; i < 1000; ++i) {
+        records.Add(std::make_pair(i * 37 % 101, std::to_string(i)));
+    }
+    auto byDistance = ArgSort(records, [](const std::pair<size_t, std::string>& record) { return record.first; });
+    auto byName = ArgSort(records, [](const std::pair<size_t, std::string>& record) { return record.second; },
+                          std::greater<std::string>());
+    for (size_t i = 1; i < records.GetLength(); ++i) {
+        const auto& previous = records.Get(byDistance->Get(i - 1));
+        const auto& current = records.Get(byDistance->Get(i));
+        assert(previous.first < current.first || (previous.first == current.first && byDistance->Get(i - 1) < byDistance->Get(i)));
+        assert(records.Get(byName->Get(i - 1)).second > records.Get(byName->Get(i)).second);
+    }
+
+    ApplyPermutation(records, *byDistance);
+    for (size_t i = 1; i < records.GetLength(); ++i) {
+        assert(records.Get(i - 1).first <= records.Get(i).first);
+    }
+
+    ArraySequence<size_t> broken;
+    for (size_t i = 0; i < records.GetLength(); ++i) {
+        broken.Add(i / 2);
+    }
+    bool thrown = false;
+    try {
+        ApplyPermutation(records, broken);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+void TestDequeSequence() {
+    DequeSequence<int> deque;
+    for (int i = 0; i < 5000; ++i) {
+        deque.PushBack(i);
+        deque.PushFront(-i - 1);
+    }
+    assert(deque.GetLength() == 10000);
+    assert(deque.GetFirst() == -5000 && deque.GetLast() == 4999);
+    assert(deque.Get(5000) == 0);
+
+    int* stable = &deque.Get(5000);
+    for (int i = 0; i < 100000; ++i) {
+        deque.PushBack(i);
+    }
+    assert(stable == &deque.Get(5000));
+
+    for (int i = 0; i < 100000; ++i) {
+        deque.PopBack();
+    }
+    for (int i = 0; i < 200000; ++i) {
+        deque.PushBack(i);
+        deque.PopFront();
+    }
+    assert(deque.GetLength() == 10000);
+    assert(std::is_sorted(deque.begin(), deque.end()));
+
+    deque.RemoveAt(1);
+    assert(deque.GetLength() == 9999);
+    auto prepended = deque.Prepend(-1);
+    assert(prepended->GetFirst() == -1 && prepended->GetLength() == 10000);
+}
+
+#ifndef _WIN32
+void TestMappedArraySequence() {
+    std::string path = "lab4_mapped_test.bin";
+    {
+        MappedArraySequence<std::pair<size_t, size_t>> edges(path, MappedOpenMode::Create);
+        for (size_t i = 0; i < 10000; ++i) {
+            edges.Add({i, i * 2});
+        }
+        edges.RemoveAt(0);
+        edges.Flush();
+    }
+    {
+        MappedArraySequence<std::pair<size_t, size_t>> edges(path, MappedOpenMode::ReadOnly);
+        assert(edges.GetLength() == 9999);
+        assert(edges.GetFirst().first == 1 && edges.GetLast().second == 9999 * 2);
+        auto copy = edges.GetSubsequence(0, 9);
+        assert(copy->GetLength() == 10 && copy->Get(9).first == 10);
+        auto appended = edges.Append({0, 0});
+        assert(appended->GetLength() == 10000 && appended->GetLast().first == 0 && appended->Get(0).first == 1);
+        auto prepended = edges.Prepend({0, 0});
+        assert(prepended->GetFirst().first == 0 && prepended->Get(1).first == 1);
+        auto inserted = edges.InsertAt({0, 0}, 5);
+        assert(inserted->Get(5).first == 0 && inserted->Get(4).first == 5 && inserted->Get(6).first == 6);
+        assert(edges.GetLength() == 9999);
+    }
+    bool thrown = false;
+    try {
+        MappedArraySequence<double> wrongType(path, MappedOpenMode::OpenExisting);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::remove(path.c_str());
+
+    // Дописывание собственного куска: рост может перенести отображение до копирования
+    {
+        MappedArraySequence<int> values(path, MappedOpenMode::Create);
+        for (int i = 0; i < 1000; ++i) {
+            values.Add(i);
+        }
+        for (int round = 0; round < 6; ++round) {
+            values.AddRange(values.Data() + 1, values.GetLength() - 1);
+        }
+        assert(values.GetLength() == 63937 && values.GetLast() == 999);
+        assert(values.Get(1000) == 1 && values.Get(1998) == 999 && values.Get(1999) == 1);
+    }
+    std::remove(path.c_str());
+}
+#endif
+
+void TestSequenceOperations() {
+    ArraySequence<int> values;
+    for (int i = 0; i < 100000; ++i) {
+        values.Add(i % 1000);
+    }
+    for (ExecutionPolicy policy : {ExecutionPolicy::Sequential, ExecutionPolicy::Parallel}) {
+        auto doubled = Map(values, [](int value) { return value * 2.0; }, policy);
+        assert(doubled->GetLength() == 100000 && doubled->Get(999) == 1998.0);
+
+        auto large = Where(values, [](int value) { return value >= 900; }, policy);
+        assert(large->GetLength() == 10000 && large->Get(0) == 900 && large->Get(100) == 900);
+
+        long long sum = Reduce(values, 0, [](int a, int b) { return a + b; }, policy);
+        assert(sum == 100LL * 999 * 1000 / 2);
+
+        auto histogram = Aggregate(values, DynamicArray<size_t>(10),
+            [](DynamicArray<size_t> buckets, int value) { ++buckets.UncheckedGet(value / 100); return buckets; },
+            [](DynamicArray<size_t> left, const DynamicArray<size_t>& right) {
+                for (size_t i = 0; i < left.GetSize(); ++i) {
+                    left.UncheckedGet(i) += right.UncheckedGet(i);
+                }
+                return left;
+            }, policy);
+        assert(histogram.Get(3) == 10000);
+
+        auto zipped = Zip(values, *doubled, policy);
+        assert(zipped->GetLength() == 100000 && zipped->Get(7).second == 14.0);
+    }
+    ForEach(values, [](int& value) { value = -value; }, ExecutionPolicy::Parallel);
+    assert(values.Get(999) == -999);
+}
+
+void TestShrdPtr() {
+    static int alive = 0;
+    struct Tracked {
+        int value;
+        explicit Tracked(int value) : value(value) { ++alive; }
+        ~Tracked() { --alive; }
+    };
+    WeekPtr<Tracked> weak;
+    {
+        auto shared = MakeShrd<Tracked>(42);
+        ShrdPtr<Tracked> copy = shared;
+        weak = WeekPtr<Tracked>(copy);
+        assert(shared->value == 42 && shared.getRefCount() == 2 && alive == 1);
+        assert(weak.lock()->value == 42);
+    }
+    assert(alive == 0);
+    assert(weak.expired() && !weak.lock());
+
+    WeekPtr<Tracked> weakCopy = weak;
+    assert(weakCopy.expired());
+
+    ShrdPtr<Sequence<int>> base = MakeShrd<ArraySequence<int>>();
+    base = base->Append(7);
+    assert(base->GetLength() == 1 && base.getRefCount() == 1);
+}
+
+void TestAtomicShrdPtr() {
+    auto shared = MakeAtomicShrd<ArraySequence<int>>();
+    shared->Add(1);
+    AtomicWeekPtr<ArraySequence<int>> weak(shared);
+    DynamicArray<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.Emplace([shared, weak]() {
+            for (int i = 0; i < 10000; ++i) {
+                AtomicShrdPtr<ArraySequence<int>> copy = shared;
+                auto locked = weak.lock();
+                assert(locked && copy->GetFirst() == 1);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    assert(shared.getRefCount() == 1);
+    shared.reset();
+    assert(weak.expired());
+}
+
+void TestLinkedList() {
+    int raw[] = {1, 2, 3};
+    LinkedList<int> list(raw, 3);
+    list.Prepend(0);
+    list.Append(4);
+    list.InsertAt(10, 2);
+    assert(list.GetLength() == 6);
+    assert(list.GetFirst() == 0 && list.GetLast() == 4 && list.Get(2) == 10);
+    LinkedList<int> copy(list);
+    copy.Set(0, -1);
+    assert(list.GetFirst() == 0 && copy.GetFirst() == -1);
+}
+
+void TestMemoryResources() {
+    Arena arena(256);
+    {
+        DynamicArray<std::string> strings(0, &arena);
+        for (int i = 0; i < 100; ++i) {
+            strings.PushBack(std::to_string(i));
+        }
+        assert(strings.Get(99) == "99" && strings.GetResource() == &arena);
+        DynamicArray<std::string> heapCopy(strings);
+        assert(heapCopy.GetResource() == nullptr && heapCopy.Get(42) == "42");
+
+        HashTableDictionary<size_t, int> table(4, &arena);
+        for (size_t i = 0; i < 200; ++i) {
+            table.Add(i, static_cast<int>(i) * 2);
+        }
+        assert(table.Get(150) == 300);
+    }
+    assert(arena.GetAllocatedBytes() > 0);
+    arena.Release();
+    assert(arena.GetAllocatedBytes() == 0);
+
+    Pool pool(sizeof(Node<int>) + 64, alignof(std::max_align_t), 8);
+    {
+        LinkedList<int> list(&pool);
+        for (int i = 0; i < 50; ++i) {
+            list.Append(i);
+        }
+        assert(list.Get(49) == 49);
+        void* reused = pool.Allocate(sizeof(Node<int>), alignof(Node<int>));
+        pool.Deallocate(reused, sizeof(Node<int>), alignof(Node<int>));
+    }
+
+    static int alive = 0;
+    struct Tracked {
+        explicit Tracked() { ++alive; }
+        ~Tracked() { --alive; }
+    };
+    WeekPtr<Tracked> weak;
+    {
+        ShrdPtr<Tracked> shared = AllocateShrd<Tracked>(&pool);
+        weak = WeekPtr<Tracked>(shared);
+        assert(alive == 1);
+    }
+    assert(alive == 0 && weak.expired());
+}
+
 void TestUndirectedGraph() {
     UndirectedGraph<int> graph;
     graph.AddVertex(0);
@@ -37,11 +549,423 @@ void TestDirectedGraph() {
     
     assert(sorted->GetLength() == 4);
     assert(sorted->Get(3) == 0);
+
+    // Пустые ячейки внешней таблицы тоже держат таблицы смежности по 25 ячеек
+    HashTableDictionary<size_t, int> single;
+    assert(graph.MemoryUsage() > 4 * single.MemoryUsage());
+
+#ifdef LAB4_ALLOCATION_STATS
+    size_t liveBefore = AllocationStats::Get(AllocationCategory::HashTable).liveBytes;
+    {
+        DirectedGraph<int> scratch;
+        scratch.AddEdge(0, 1, 1);
+        assert(AllocationStats::Get(AllocationCategory::HashTable).liveBytes > liveBefore);
+    }
+    assert(AllocationStats::Get(AllocationCategory::HashTable).liveBytes == liveBefore);
+#endif
+}
+
+template <typename Graph>
+bool SameGraph(const Graph& expected, const Graph& actual) {
+    if (expected.GetVertexCount() != actual.GetVertexCount()) {
+        return false;
+    }
+    auto vertices = expected.GetVertices();
+    for (size_t i = 0; i < vertices->GetLength(); ++i) {
+        auto edges = expected.GetEdges(vertices->Get(i));
+        auto other = actual.GetEdges(vertices->Get(i));
+        if (edges->GetLength() != other->GetLength()) {
+            return false;
+        }
+        for (size_t j = 0; j < edges->GetLength(); ++j) {
+            bool found = false;
+            for (size_t k = 0; k < other->GetLength() && !found; ++k) {
+                found = other->Get(k) == edges->Get(j);
+            }
+            if (!found) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void TestGraphBatch() {
+    // Повторы, петли и рёбра к уже существующим вершинам: результат должен совпасть с AddEdge по порядку
+    std::mt19937 generator(49);
+    std::uniform_int_distribution<size_t> vertex(0, 9999);
+    std::uniform_int_distribution<int> weight(1, 100);
+    ArraySequence<GraphEdge<int>> batch;
+    for (size_t i = 0; i < 60000; ++i) {
+        size_t from = vertex(generator);
+        batch.Add(GraphEdge<int>{from, i % 10 == 0 ? from : vertex(generator) % (i % 3 == 0 ? 10 : 10000), weight(generator)});
+    }
+    DirectedGraph<int> directed;
+    UndirectedGraph<int> undirected;
+    DirectedGraph<int> directedBatch;
+    UndirectedGraph<int> undirectedBatch;
+    DirectedGraph<int> directedParallel;
+    UndirectedGraph<int> undirectedParallel;
+    for (size_t i = 0; i < 100; ++i) {
+        directed.AddEdge(i, i + 1, 1);
+        undirected.AddEdge(i, i + 1, 1);
+        directedBatch.AddEdge(i, i + 1, 1);
+        undirectedBatch.AddEdge(i, i + 1, 1);
+        directedParallel.AddEdge(i, i + 1, 1);
+        undirectedParallel.AddEdge(i, i + 1, 1);
+    }
+    for (const GraphEdge<int>& edge : batch) {
+        directed.AddEdge(edge.from, edge.to, edge.weight);
+        undirected.AddEdge(edge.from, edge.to, edge.weight);
+    }
+    directedBatch.AddEdges(batch);
+    undirectedBatch.AddEdges(batch);
+    directedParallel.AddEdges(batch, ExecutionPolicy::Parallel);
+    undirectedParallel.AddEdges(batch.Data(), batch.GetLength(), ExecutionPolicy::Parallel);
+    assert(SameGraph(directed, directedBatch) && SameGraph(directed, directedParallel));
+    assert(SameGraph(undirected, undirectedBatch) && SameGraph(undirected, undirectedParallel));
+
+    ArraySequence<size_t> isolated;
+    isolated.Add(20000);
+    isolated.Add(5);
+    directedBatch.AddVertices(isolated);
+    assert(directedBatch.GetVertexCount() == directed.GetVertexCount() + 1);
+    assert(directedBatch.GetEdges(20000)->GetLength() == 0);
+
+    // Таблица смежности переносится во внешнюю таблицу без копирования и сохраняет ёмкость
+    HashTableDictionary<size_t, HashTableDictionary<size_t, int>> adjacency;
+    size_t capacity = HashTableDictionary<size_t, int>::CapacityFor(1000);
+    HashTableDictionary<size_t, int> edges(capacity);
+    for (size_t i = 0; i < 1000; ++i) {
+        edges.Add(i, static_cast<int>(i));
+    }
+    adjacency.Add(7, std::move(edges));
+    for (size_t i = 0; i < 100; ++i) {
+        adjacency.Add(100 + i, HashTableDictionary<size_t, int>());
+    }
+    assert(adjacency.Get(7).GetCount() == 1000 && adjacency.Get(7).Get(999) == 999);
+    assert(adjacency.Get(7).GetCapacity() == capacity);
+}
+
+void TestGraphGenerators() {
+    // Один seed — одни и те же рёбра, другой seed — другие
+    auto first = RmatGenerator<int>(10, 8, 7, EdgeWeights<int>::Uniform(1, 9)).Edges();
+    auto second = RmatGenerator<int>(10, 8, 7, EdgeWeights<int>::Uniform(1, 9)).Edges();
+    auto other = RmatGenerator<int>(10, 8, 8, EdgeWeights<int>::Uniform(1, 9)).Edges();
+    assert(first.GetSize() == 8 * 1024 && second.GetSize() == first.GetSize());
+    bool same = true;
+    bool differs = false;
+    for (size_t i = 0; i < first.GetSize(); ++i) {
+        const GraphEdge<int>& edge = first.UncheckedGet(i);
+        assert(edge.from < 1024 && edge.to < 1024 && edge.weight >= 1 && edge.weight <= 9);
+        same = same && edge.from == second.UncheckedGet(i).from && edge.to == second.UncheckedGet(i).to &&
+               edge.weight == second.UncheckedGet(i).weight;
+        differs = differs || edge.from != other.UncheckedGet(i).from || edge.to != other.UncheckedGet(i).to;
+    }
+    assert(same && differs);
+
+    // G(n, p): без петель и повторов, число рёбер около p * n * (n - 1)
+    DirectedGraph<double> random;
+    ErdosRenyiGenerator<double> erdos(2000, 0.005, 1, EdgeWeights<double>::Exponential(2.0));
+    erdos.Fill(random);
+    assert(random.GetVertexCount() == 2000);
+    size_t arcs = 0;
+    erdos.Generate([&arcs](const GraphEdge<double>& edge) {
+        assert(edge.from != edge.to && edge.from < 2000 && edge.to < 2000 && edge.weight >= 0);
+        ++arcs;
+    });
+    assert(arcs > 18000 && arcs < 22000);
+    size_t stored = 0;
+    auto vertices = random.GetVertices();
+    for (size_t i = 0; i < vertices->GetLength(); ++i) {
+        stored += random.GetEdges(vertices->Get(i))->GetLength();
+    }
+    assert(stored == arcs);
+    // Поток длиннее пакета: результат тот же, что и одним пакетом
+    DirectedGraph<double> batched;
+    erdos.Fill(batched, ExecutionPolicy::Sequential, 1000);
+    assert(SameGraph(random, batched));
+    assert(ErdosRenyiGenerator<int>(50, 1.0, 1, EdgeWeights<int>(), false).Edges().GetSize() == 50 * 49 / 2);
+
+    // Полная решётка: кратчайший путь между углами равен манхэттенскому расстоянию
+    UndirectedGraph<int> grid;
+    GridGenerator<int>(40, 30, 3).Fill(grid, ExecutionPolicy::Parallel);
+    assert(grid.GetVertexCount() == 1200 && grid.FindBestPath(0, 1199) == 39 + 29);
+    DirectedGraph<int> roads;
+    GridGenerator<int>(40, 30, 3, EdgeWeights<int>::Constant(1)).Fill(roads);
+    assert(roads.FindBestPath(1199, 0) == 39 + 29);
+    assert(GridGenerator<int>(40, 30, 3, EdgeWeights<int>(), 0.5).Edges().GetSize() < 40 * 29 + 39 * 30);
+
+    UndirectedGraph<int> scaleFree;
+    BarabasiAlbertGenerator<int>(3000, 3, 5).Fill(scaleFree);
+    assert(scaleFree.GetVertexCount() == 3000 && scaleFree.FindConnectedComponents()->GetLength() == 1);
+    assert(BarabasiAlbertGenerator<int>(3000, 3, 5).Edges().GetSize() == 6 + 2996 * 3);
+
+    // TopologicalSort возвращает стек обратного обхода: каждая дуга ациклического графа ведёт к более ранней позиции
+    DirectedGraph<int> dag;
+    DagGenerator<int>(500, 3000, 11).Fill(dag);
+    assert(dag.GetVertexCount() == 500);
+    // Разреженные графы: изолированные вершины тоже входят в граф
+    DirectedGraph<int> sparseErdos;
+    ErdosRenyiGenerator<int>(1000, 0.001, 3).Fill(sparseErdos);
+    assert(sparseErdos.GetVertexCount() == 1000);
+    DirectedGraph<int> sparseDag;
+    DagGenerator<int>(1000, 200, 3).Fill(sparseDag);
+    assert(sparseDag.GetVertexCount() == 1000);
+    UndirectedGraph<int> sparseRmat;
+    RmatGenerator<int>(12, 1, 3).Fill(sparseRmat);
+    assert(sparseRmat.GetVertexCount() == 4096);
+    auto sorted = dag.TopologicalSort();
+    assert(sorted->GetLength() == dag.GetVertexCount());
+    HashTableDictionary<size_t, size_t> position;
+    for (size_t i = 0; i < sorted->GetLength(); ++i) {
+        position.Add(sorted->Get(i), i);
+    }
+    for (size_t i = 0; i < sorted->GetLength(); ++i) {
+        auto edges = dag.GetEdges(sorted->Get(i));
+        for (size_t j = 0; j < edges->GetLength(); ++j) {
+            assert(position.Get(edges->Get(j).first) < i);
+        }
+    }
+}
+
+#ifndef _WIN32
+void TestMappedGraph() {
+    std::string path = "lab4_graph_test.bin";
+    DirectedGraph<int> directed;
+    directed.AddEdge(0, 1, 5);
+    directed.AddEdge(1, 2, 3);
+    directed.AddEdge(2, 3, 1);
+    directed.AddEdge(3, 1, 2);
+    directed.AddEdge(40, 0, 7);
+    directed.Save(path);
+    {
+        MappedGraph<int> mapped(path);
+        assert(mapped.IsDirected() && mapped.GetVertexCount() == 5 && mapped.GetEdgeCount() == 5);
+        auto vertices = mapped.GetVertices();
+        auto original = directed.GetVertices();
+        for (size_t i = 0; i < vertices->GetLength(); ++i) {
+            assert(vertices->Get(i) == original->Get(i));
+            assert(mapped.GetEdges(vertices->Get(i))->GetLength() == directed.GetEdges(vertices->Get(i))->GetLength());
+        }
+        auto distances = mapped.ShortestPaths(40);
+        auto expected = directed.ShortestPaths(40);
+        for (size_t i = 0; i < distances->GetLength(); ++i) {
+            assert(distances->Get(i) == expected->Get(i));
+        }
+        assert(mapped.FindBestPath(0, 3) == 9);
+        assert(mapped.FindStronglyConnectedComponents()->GetLength() == 3);
+        auto sorted = mapped.TopologicalSort();
+        auto expectedOrder = directed.TopologicalSort();
+        for (size_t i = 0; i < sorted->GetLength(); ++i) {
+            assert(sorted->Get(i) == expectedOrder->Get(i));
+        }
+        bool thrown = false;
+        try {
+            mapped.AddEdge(0, 1, 1);
+        } catch (const std::logic_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    UndirectedGraph<double> undirected;
+    undirected.AddEdge(0, 1, 1.5);
+    undirected.AddEdge(1, 2, 0.5);
+    undirected.AddEdge(0, 2, 4.0);
+    undirected.AddEdge(7, 8, 1.0);
+    undirected.Save(path);
+    {
+        MappedGraph<double> mapped(path);
+        assert(!mapped.IsDirected() && mapped.GetEdgeCount() == 8);
+        assert(mapped.FindBestPath(0, 2) == 2.0);
+        assert(mapped.FindConnectedComponents()->GetLength() == 2);
+        size_t index = mapped.FindVertexIndex(1);
+        assert(mapped.GetVertexId(index) == 1 && mapped.GetNeighborIndices(index).GetLength() == 2);
+        assert(mapped.FindVertexIndex(100) == mapped.GetVertexCount());
+    }
+    bool thrown = false;
+    try {
+        MappedGraph<int> wrongType(path);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Конец ребра за пределами вершин должен отвергаться при открытии, а не при обходе
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    GraphFileHeader header;
+    size_t headerRead = std::fread(&header, sizeof(header), 1, file);
+    assert(headerRead == 1);
+    uint64_t corrupted = uint64_t(1) << 30;
+    std::fseek(file, static_cast<long>(header.targetsOffset), SEEK_SET);
+    std::fwrite(&corrupted, sizeof(corrupted), 1, file);
+    std::fclose(file);
+    thrown = false;
+    try {
+        MappedGraph<double> corruptedGraph(path);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::remove(path.c_str());
 }
 
+void TestGraphLoader() {
+    std::string path = "lab4_loader_test.gr";
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    std::fputs("c road network\np sp 4 5\na 1 2 7\na 2 3 1\r\na 3 4 2\n\na 1 4 20\nc tail\na 4 1 3", file);
+    std::fclose(file);
+    DirectedGraph<int> road;
+    GraphLoadStats stats = LoadGraph(path, road);
+    assert(stats.edges == 5 && stats.vertices == 4 && stats.bytes > 0);
+    assert(road.FindBestPath(1, 4) == 10 && road.FindBestPath(4, 3) == 11);
+
+    path = "lab4_loader_test.mtx";
+    file = std::fopen(path.c_str(), "w");
+    std::fputs("%%MatrixMarket matrix coordinate real symmetric\n% comment\n3 3 3\n1 2 0.5\n2 3 1.5e0\n3 3 2\n", file);
+    std::fclose(file);
+    DirectedGraph<double> symmetric;
+    LoadGraph(path, symmetric);
+    assert(symmetric.FindBestPath(3, 1) == 2.0);
+    UndirectedGraph<double> matrix;
+    LoadGraph(path, matrix);
+    assert(matrix.FindBestPath(1, 3) == 2.0 && matrix.GetEdges(2)->GetLength() == 2);
+
+    // Размеры из заголовка: изолированные вершины входят в граф, число рёбер сверяется с заголовком
+    file = std::fopen(path.c_str(), "w");
+    std::fputs("%%MatrixMarket matrix coordinate pattern general\n4 4 2\n1 2\n3 1\n", file);
+    std::fclose(file);
+    UndirectedGraph<int> padded;
+    assert(LoadGraph(path, padded).vertices == 4 && padded.GetEdges(4)->GetLength() == 0);
+    // skew-symmetric — не symmetric: обратная дуга получает вес с обратным знаком
+    file = std::fopen(path.c_str(), "w");
+    std::fputs("%%MatrixMarket matrix coordinate integer skew-symmetric\n3 3 2\n2 1 4\n3 2 -1\n", file);
+    std::fclose(file);
+    DirectedGraph<int> skew;
+    LoadGraph(path, skew);
+    assert(skew.GetEdges(1)->GetLength() == 1 && skew.GetEdges(1)->Get(0) == std::make_pair(size_t(2), -4));
+    assert(skew.GetEdges(2)->GetLength() == 2 && skew.GetEdges(3)->Get(0) == std::make_pair(size_t(2), -1));
+    bool skewRejected = false;
+    try {
+        UndirectedGraph<int> skewUndirected;
+        LoadGraph(path, skewUndirected);
+    } catch (const std::runtime_error&) {
+        skewRejected = true;
+    }
+    assert(skewRejected);
+    const char* invalidHeaders[] = {"p sp 5 3\na 1 2 1\na 2 5 1\n", "p sp 5 2\na 1 2 1\na 2 6 1\n",
+                                    "p sp 5 2\na 0 2 1\na 2 5 1\n"};
+    for (const char* text : invalidHeaders) {
+        file = std::fopen("lab4_loader_test.gr", "w");
+        std::fputs(text, file);
+        std::fclose(file);
+        bool rejected = false;
+        try {
+            ParseGraphFile<int>("lab4_loader_test.gr");
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        assert(rejected);
+    }
+    file = std::fopen("lab4_loader_test.gr", "w");
+    std::fputs("p sp 5 2\na 1 2 1\na 2 5 1\n", file);
+    std::fclose(file);
+    DirectedGraph<int> isolated;
+    assert(LoadGraph("lab4_loader_test.gr", isolated).vertices == 5);
+
+    // Файл больше нескольких кусков: строки на границах кусков не должны теряться
+    path = "lab4_loader_test.txt";
+    file = std::fopen(path.c_str(), "w");
+    std::fputs("# FromNodeId\tToNodeId\n", file);
+    size_t sum = 0;
+    for (size_t i = 0; i < 300000; ++i) {
+        std::fprintf(file, "%zu\t%zu\n", i, i * 7 % 1000);
+        sum += i + i * 7 % 1000;
+    }
+    std::fclose(file);
+    ThreadPool pool(3);
+    ParsedGraph<int> parsed = ParseGraphFile<int>(path, GraphFileFormat::Auto, pool);
+    assert(parsed.edges.GetSize() == 300000);
+    size_t parsedSum = 0;
+    for (const GraphEdge<int>& edge : parsed.edges) {
+        parsedSum += edge.from + edge.to;
+        assert(edge.weight == 1);
+    }
+    assert(parsedSum == sum);
+    // Пул вызывающего используется и для построения графа
+    DirectedGraph<int> pooled;
+    LoadGraph(path, pooled, GraphFileFormat::Auto, pool);
+    assert(pooled.GetVertexCount() == 300000 && pooled.GetEdges(299999)->GetLength() == 1);
+
+    file = std::fopen(path.c_str(), "w");
+    std::fputs("1 2 3\n4 x\n", file);
+    std::fclose(file);
+    bool thrown = false;
+    try {
+        ParseGraphFile<int>(path);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    // Идентификатор больше SIZE_MAX не должен молча усекаться
+    file = std::fopen(path.c_str(), "w");
+    std::fputs("99999999999999999999999 1\n", file);
+    std::fclose(file);
+    thrown = false;
+    try {
+        ParseGraphFile<int>(path);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::remove(path.c_str());
+    std::remove("lab4_loader_test.gr");
+    std::remove("lab4_loader_test.mtx");
+}
+#endif
+
 void Test() {
+    TestShrdPtr();
+    std::cout<<"success"<<std::endl;
+    TestAtomicShrdPtr();
+    std::cout<<"success"<<std::endl;
+    TestDynamicArray();
+    std::cout<<"success"<<std::endl;
+    TestLinkedList();
+    std::cout<<"success"<<std::endl;
+    TestArraySequenceAccess();
+    std::cout<<"success"<<std::endl;
+    TestSorters();
+    std::cout<<"success"<<std::endl;
+    TestExternalSort();
+    std::cout<<"success"<<std::endl;
+    TestSelection();
+    std::cout<<"success"<<std::endl;
+    TestArgSort();
+    std::cout<<"success"<<std::endl;
+    TestDequeSequence();
+    std::cout<<"success"<<std::endl;
+    TestSequenceOperations();
+    std::cout<<"success"<<std::endl;
+#ifndef _WIN32
+    TestMappedArraySequence();
+    std::cout<<"success"<<std::endl;
+#endif
+    TestMemoryResources();
+    std::cout<<"success"<<std::endl;
     TestUndirectedGraph();
     std::cout<<"success"<<std::endl;
     TestDirectedGraph();
     std::cout<<"success"<<std::endl;
+    TestGraphBatch();
+    std::cout<<"success"<<std::endl;
+    TestGraphGenerators();
+    std::cout<<"success"<<std::endl;
+#ifndef _WIN32
+    TestMappedGraph();
+    std::cout<<"success"<<std::endl;
+    TestGraphLoader();
+    std::cout<<"success"<<std::endl;
+#endif
 }
@@ -1,6 +1,8 @@
 #ifndef HASHTABLE_H
 #define HASHTABLE_H
 
+#include "MemoryResource.h"
+#include "AllocationStats.h"
 #include <stdexcept>
 #include <utility>
 #include <memory>
@@ -21,6 +23,25 @@ private:
     size_t count;
     size_t capacity;
     Hash hash;
+    MemoryResource* resource;
+
+    Entry* allocateTable(size_t size) const {
+        Entry* memory = static_cast<Entry*>(AllocateFrom(resource, size * sizeof(Entry), alignof(Entry)));
+        try {
+            std::uninitialized_default_construct(memory, memory + size);
+        } catch (...) {
+            DeallocateFrom(resource, memory, size * sizeof(Entry), alignof(Entry));
+            throw;
+        }
+        AllocationStats::RecordAllocation(AllocationCategory::HashTable, size * sizeof(Entry));
+        return memory;
+    }
+
+    void freeTable(Entry* oldTable, size_t size) const {
+        AllocationStats::RecordDeallocation(AllocationCategory::HashTable, size * sizeof(Entry));
+        std::destroy(oldTable, oldTable + size);
+        DeallocateFrom(resource, oldTable, size * sizeof(Entry), alignof(Entry));
+    }
 
     size_t hashKey(const TKey& key) const {
         return hash(key) % capacity;
@@ -32,16 +53,16 @@ private:
 
         capacity = newCapacity;
         count = 0;
-        table = new Entry[capacity];
+        table = allocateTable(capacity);
 
         for (size_t i = 0; i < oldCapacity; ++i) {
             if (oldTable[i].occupied && !oldTable[i].wasDeleted) {
-                Add(oldTable[i].key, oldTable[i].element);
+                Add(oldTable[i].key, std::move(oldTable[i].element));
             }
         }
 
 
-        delete[] oldTable;
+        freeTable(oldTable, oldCapacity);
     }
 
     size_t findNode(const TKey& key) const {
@@ -66,17 +87,43 @@ private:
     }
 
 
+    template <typename Element>
+    void insert(const TKey& key, Element&& element) {
+        if (count >= capacity * 0.75) {
+            resizeTable(capacity * 2);
+        }
+
+        size_t index = findNode(key);
+
+        if (index == -1) {
+            index = hashKey(key);
+            size_t originalIndex = index;
+            while (table[index].occupied) {
+                index = (index + 1) % capacity;
+                if (index == originalIndex) {
+                    throw std::runtime_error("Hash table is full");
+                }
+            }
+        }
+
+        table[index].key = key;
+        table[index].element = std::forward<Element>(element);
+        table[index].occupied = true;
+        table[index].wasDeleted = false;
+        ++count;
+    }
+
 public:
-    explicit HashTable(size_t initialCapacity = 25)
-        : count(0) {
+    explicit HashTable(size_t initialCapacity = 25, MemoryResource* resource = nullptr)
+        : count(0), resource(resource) {
 
         capacity = initialCapacity > 0 ? initialCapacity : 25;
 
-        table = new Entry[capacity];
+        table = allocateTable(capacity);
     }
 
-    HashTable(const HashTable& other) : count(other.count), capacity(other.capacity), hash(other.hash) {
-        table = new Entry[capacity];
+    HashTable(const HashTable& other) : count(other.count), capacity(other.capacity), hash(other.hash), resource(nullptr) {
+        table = allocateTable(capacity);
         for (size_t i = 0; i < capacity; ++i) {
             table[i] = other.table[i];
         }
@@ -84,11 +131,11 @@ public:
 
     HashTable& operator=(const HashTable& other) {
         if (this != &other) {
-            delete[] table;
+            freeTable(table, capacity);
             count = other.count;
             capacity = other.capacity;
             hash = other.hash;
-            table = new Entry[capacity];
+            table = allocateTable(capacity);
             for (size_t i = 0; i < capacity; ++i) {
                 table[i] = other.table[i];
             }
@@ -96,13 +143,47 @@ public:
         return *this;
     }
 
+    // Перемещение обменивает таблицы: перемещённый объект остаётся рабочей таблицей (с содержимым приёмника)
+    HashTable& operator=(HashTable&& other) noexcept {
+        std::swap(table, other.table);
+        std::swap(count, other.count);
+        std::swap(capacity, other.capacity);
+        std::swap(hash, other.hash);
+        std::swap(resource, other.resource);
+        return *this;
+    }
+
     ~HashTable() {
-        delete[] table;
+        freeTable(table, capacity);
+    }
+
+    // Ёмкость, при которой expectedCount элементов помещаются без перехеширования
+    static size_t CapacityFor(size_t expectedCount) {
+        return expectedCount + expectedCount / 3 + 1;
     }
 
     size_t GetCount() const { return count; }
     size_t GetCapacity() const { return capacity; }
 
+    // Увеличивает таблицу заранее, чтобы expectedCount элементов поместились без перехеширования
+    void Reserve(size_t expectedCount) {
+        size_t required = CapacityFor(expectedCount);
+        if (required > capacity) {
+            resizeTable(required);
+        }
+    }
+
+    // Пустые ячейки тоже учитываются: в них лежат сконструированные по умолчанию ключ и значение
+    size_t MemoryUsage() const {
+        size_t total = sizeof(*this) + capacity * sizeof(Entry);
+        if constexpr (HasMemoryUsage<TKey>::value || HasMemoryUsage<TElement>::value) {
+            for (size_t i = 0; i < capacity; ++i) {
+                total += OwnedMemoryUsage(table[i].key) + OwnedMemoryUsage(table[i].element);
+            }
+        }
+        return total;
+    }
+
     // TElement Get(const TKey& key) const {
     //     size_t index = findNode(key);
     //     if (index == -1) {
@@ -120,28 +201,12 @@ public:
     }
 
     void Add(const TKey& key, const TElement& element) {
-        if (count >= capacity * 0.75) {
-            resizeTable(capacity * 2);
-        }
-
-        size_t index = findNode(key);
-
-        if (index == -1) {
-            index = hashKey(key);
-            size_t originalIndex = index;
-            while (table[index].occupied) {
-                index = (index + 1) % capacity;
-                if (index == originalIndex) {
-                    throw std::runtime_error("Hash table is full");
-                }
-            }
-        }
+        insert(key, element);
+    }
 
-        table[index].key = key;
-        table[index].element = element;
-        table[index].occupied = true;
-        table[index].wasDeleted = false;
-        ++count;
+    // Значение переносится без копирования (вложенные таблицы смежности графа)
+    void Add(const TKey& key, TElement&& element) {
+        insert(key, std::move(element));
     }
 
     void Remove(const TKey& key) {
@@ -221,7 +286,7 @@ public:
     }
 
     ShrdPtr<Sequence<std::pair<TKey, TElement>>> GetAllItems() const {
-        auto items = ShrdPtr<Sequence<std::pair<TKey, TElement>>>(new ArraySequence<std::pair<TKey, TElement>>());
+        ShrdPtr<Sequence<std::pair<TKey, TElement>>> items = MakeShrd<ArraySequence<std::pair<TKey, TElement>>>();
         for (const auto& item : *this) {
             items = items->Append(item);
         }
@@ -27,10 +27,14 @@ private:
     };
 
 public:
-    explicit HashTableDictionary(size_t initialCapacity = 25) : hashTable(initialCapacity) {}
+    explicit HashTableDictionary(size_t initialCapacity = 25, MemoryResource* resource = nullptr)
+        : hashTable(initialCapacity, resource) {}
 
     size_t GetCount() const override { return hashTable.GetCount(); }
     size_t GetCapacity() const override { return hashTable.GetCapacity(); }
+    size_t MemoryUsage() const override { return sizeof(*this) - sizeof(hashTable) + hashTable.MemoryUsage(); }
+
+    void Reserve(size_t expectedCount) { hashTable.Reserve(expectedCount); }
 
     // TElement Get(const TKey& key) const override { return hashTable.Get(key); }
 
@@ -40,6 +44,14 @@ public:
         hashTable.Add(key, element);
     }
 
+    void Add(const TKey& key, TElement&& element) {
+        hashTable.Add(key, std::move(element));
+    }
+
+    static size_t CapacityFor(size_t expectedCount) {
+        return HashTable<TKey, TElement>::CapacityFor(expectedCount);
+    }
+
     void Remove(const TKey& key) override {
         hashTable.Remove(key);
     }
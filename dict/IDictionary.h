@@ -9,6 +9,7 @@ public:
     virtual ~IDictionary() = default;
     virtual size_t GetCount() const = 0;
     virtual size_t GetCapacity() const = 0;
+    virtual size_t MemoryUsage() const = 0;
     // virtual TElement Get(const TKey& key) const = 0;
     virtual TElement& Get(const TKey& key) const = 0;
     virtual void Add(const TKey& key, const TElement& element) = 0;